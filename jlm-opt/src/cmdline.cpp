@@ -84,7 +84,28 @@ parse_cmdline(int argc, char ** argv, jlm::cmdline_options & options)
 		, clEnumValN(jlm::optimization::pll, "pll", "Node pull in")
 		, clEnumValN(jlm::optimization::red, "red", "Node reductions")
 		, clEnumValN(jlm::optimization::ivt, "ivt", "Theta-gamma inversion")
-		, clEnumValN(jlm::optimization::url, "url", "Loop unrolling"))
+		, clEnumValN(jlm::optimization::url, "url", "Loop unrolling")
+		, clEnumValN(jlm::optimization::usw, "usw", "Loop unswitching")
+		, clEnumValN(jlm::optimization::ldl, "ldl", "Loop deletion")
+		, clEnumValN(jlm::optimization::tre, "tre", "Tail recursion elimination")
+		, clEnumValN(jlm::optimization::pel, "pel", "Loop peeling")
+		, clEnumValN(jlm::optimization::pts, "pts", "Points-to based memory state splitting")
+		, clEnumValN(jlm::optimization::m2r, "m2r", "Alloca promotion")
+		, clEnumValN(jlm::optimization::dse, "dse", "Dead store elimination")
+		, clEnumValN(jlm::optimization::slf, "slf", "Store-to-load forwarding")
+		, clEnumValN(jlm::optimization::sra, "sra", "Scalar replacement of aggregates")
+		, clEnumValN(jlm::optimization::clf, "clf", "Constant load folding")
+		, clEnumValN(jlm::optimization::h2s, "h2s", "Heap-to-stack promotion")
+		, clEnumValN(jlm::optimization::lsf, "lsf", "Load state fan-out")
+		, clEnumValN(jlm::optimization::mrs, "mrs", "Mod/ref summaries")
+		, clEnumValN(jlm::optimization::mex, "mex", "Memcpy and memset expansion")
+		, clEnumValN(jlm::optimization::scp, "scp", "Sparse conditional constant propagation")
+		, clEnumValN(jlm::optimization::icp, "icp", "Interprocedural constant propagation")
+		, clEnumValN(jlm::optimization::ras, "ras", "Reassociation")
+		, clEnumValN(jlm::optimization::ifc, "ifc", "If-conversion")
+		, clEnumValN(jlm::optimization::vra, "vra", "Value range analysis")
+		, clEnumValN(jlm::optimization::nrw, "nrw", "Bit-width narrowing")
+		, clEnumValN(jlm::optimization::dvt, "dvt", "Devirtualization"))
 	, cl::desc("Perform optimization"));
 
 	cl::ParseCommandLineOptions(argc, argv);
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_IR_ATTRIBUTES_HPP
+#define JLM_IR_ATTRIBUTES_HPP
+
+#include <unordered_map>
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+class lambda_node;
+
+/* function attributes */
+
+enum class fctattribute {readnone, readonly, nounwind, norecurse};
+
+class fctattributes final {
+public:
+	inline
+	fctattributes() noexcept
+	: mask_(0)
+	{}
+
+	inline void
+	insert(const fctattribute & attribute) noexcept
+	{
+		mask_ |= bit(attribute);
+	}
+
+	inline bool
+	contains(const fctattribute & attribute) const noexcept
+	{
+		return (mask_ & bit(attribute)) != 0;
+	}
+
+	inline bool
+	empty() const noexcept
+	{
+		return mask_ == 0;
+	}
+
+	inline bool
+	operator==(const fctattributes & other) const noexcept
+	{
+		return mask_ == other.mask_;
+	}
+
+	inline bool
+	operator!=(const fctattributes & other) const noexcept
+	{
+		return !(*this == other);
+	}
+
+private:
+	static inline unsigned
+	bit(const fctattribute & attribute) noexcept
+	{
+		return 1u << static_cast<unsigned>(attribute);
+	}
+
+	unsigned mask_;
+};
+
+/**
+* \brief Infers the attributes of all lambdas
+*
+* A lambda is readnone if neither it nor its callees access memory, and readonly if
+* they do not write memory. It is nounwind and norecurse if all its callees are known,
+* nounwind, and norecurse, and it is not part of a phi node. Calls to unknown functions
+* are assumed to access memory, unwind, and recurse.
+*/
+std::unordered_map<const lambda_node*, fctattributes>
+infer_attributes(const jive::graph & rvsdg);
+
+}
+
+#endif
@@ -6,6 +6,7 @@
 #ifndef JLM_IR_IPGRAPH_H
 #define JLM_IR_IPGRAPH_H
 
+#include <jlm/ir/attributes.hpp>
 #include <jlm/ir/cfg.hpp>
 #include <jlm/ir/tac.hpp>
 #include <jlm/ir/types.hpp>
@@ -237,6 +238,18 @@ public:
 		cfg_ = std::move(cfg);
 	}
 
+	inline const fctattributes &
+	attributes() const noexcept
+	{
+		return attributes_;
+	}
+
+	inline void
+	set_attributes(const fctattributes & attributes) noexcept
+	{
+		attributes_ = attributes;
+	}
+
 	static inline function_node *
 	create(
 		jlm::ipgraph & clg,
@@ -254,6 +267,7 @@ private:
 	ptrtype type_;
 	std::string name_;
 	jlm::linkage linkage_;
+	fctattributes attributes_;
 	std::unique_ptr<jlm::cfg> cfg_;
 };
 
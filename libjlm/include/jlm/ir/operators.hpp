@@ -12,6 +12,7 @@
 #include <jlm/ir/operators/getelementptr.hpp>
 #include <jlm/ir/operators/lambda.hpp>
 #include <jlm/ir/operators/load.hpp>
+#include <jlm/ir/operators/memcpy.hpp>
 #include <jlm/ir/operators/operators.hpp>
 #include <jlm/ir/operators/sext.hpp>
 #include <jlm/ir/operators/store.hpp>
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_IR_OPERATORS_MEMCPY_HPP
+#define JLM_IR_OPERATORS_MEMCPY_HPP
+
+#include <jive/arch/addresstype.h>
+#include <jive/rvsdg/simple-node.h>
+#include <jive/types/bitstring/type.h>
+
+#include <jlm/ir/tac.hpp>
+#include <jlm/ir/types.hpp>
+
+namespace jlm {
+
+/* memcpy operator */
+
+/*
+	s1 ... sN = memcpy_op d s l s1 ... sN
+
+	Copies l bytes from address s to address d. The memory regions must not overlap.
+*/
+class memcpy_op final : public jive::simple_op {
+public:
+	virtual
+	~memcpy_op() noexcept;
+
+	inline
+	memcpy_op(
+		const jlm::ptrtype & dtype,
+		const jlm::ptrtype & stype,
+		const jive::bittype & ltype,
+		size_t nstates,
+		size_t alignment)
+	: simple_op(create_srcports(dtype, stype, ltype, nstates),
+			std::vector<jive::port>(nstates, {jive::memtype::instance()}))
+	, alignment_(alignment)
+	{}
+
+	virtual bool
+	operator==(const operation & other) const noexcept override;
+
+	virtual std::string
+	debug_string() const override;
+
+	virtual std::unique_ptr<jive::operation>
+	copy() const override;
+
+	inline size_t
+	nstates() const noexcept
+	{
+		return nresults();
+	}
+
+	inline size_t
+	alignment() const noexcept
+	{
+		return alignment_;
+	}
+
+private:
+	static inline std::vector<jive::port>
+	create_srcports(
+		const ptrtype & dtype,
+		const ptrtype & stype,
+		const jive::bittype & ltype,
+		size_t nstates)
+	{
+		std::vector<jive::port> ports({dtype, stype, ltype});
+		std::vector<jive::port> states(nstates, {jive::memtype::instance()});
+		ports.insert(ports.end(), states.begin(), states.end());
+		return ports;
+	}
+
+	size_t alignment_;
+};
+
+static inline std::unique_ptr<jlm::tac>
+create_memcpy_tac(
+	const variable * destination,
+	const variable * source,
+	const variable * length,
+	size_t alignment,
+	jlm::variable * state)
+{
+	auto dt = dynamic_cast<const jlm::ptrtype*>(&destination->type());
+	if (!dt) throw jlm::error("expected pointer type.");
+
+	auto st = dynamic_cast<const jlm::ptrtype*>(&source->type());
+	if (!st) throw jlm::error("expected pointer type.");
+
+	auto lt = dynamic_cast<const jive::bittype*>(&length->type());
+	if (!lt) throw jlm::error("expected bits type.");
+
+	jlm::memcpy_op op(*dt, *st, *lt, 1, alignment);
+	return tac::create(op, {destination, source, length, state}, {state});
+}
+
+static inline std::vector<jive::output*>
+create_memcpy(
+	jive::output * destination,
+	jive::output * source,
+	jive::output * length,
+	const std::vector<jive::output*> & states,
+	size_t alignment)
+{
+	auto dt = dynamic_cast<const jlm::ptrtype*>(&destination->type());
+	if (!dt) throw jlm::error("expected pointer type.");
+
+	auto st = dynamic_cast<const jlm::ptrtype*>(&source->type());
+	if (!st) throw jlm::error("expected pointer type.");
+
+	auto lt = dynamic_cast<const jive::bittype*>(&length->type());
+	if (!lt) throw jlm::error("expected bits type.");
+
+	std::vector<jive::output*> operands({destination, source, length});
+	operands.insert(operands.end(), states.begin(), states.end());
+
+	jlm::memcpy_op op(*dt, *st, *lt, states.size(), alignment);
+	return jive::simple_node::create_normalized(destination->region(), op, operands);
+}
+
+/* memset operator */
+
+/*
+	s1 ... sN = memset_op d v l s1 ... sN
+
+	Sets l bytes at address d to the byte value v.
+*/
+class memset_op final : public jive::simple_op {
+public:
+	virtual
+	~memset_op() noexcept;
+
+	inline
+	memset_op(
+		const jlm::ptrtype & dtype,
+		const jive::bittype & ltype,
+		size_t nstates,
+		size_t alignment)
+	: simple_op(create_srcports(dtype, ltype, nstates),
+			std::vector<jive::port>(nstates, {jive::memtype::instance()}))
+	, alignment_(alignment)
+	{}
+
+	virtual bool
+	operator==(const operation & other) const noexcept override;
+
+	virtual std::string
+	debug_string() const override;
+
+	virtual std::unique_ptr<jive::operation>
+	copy() const override;
+
+	inline size_t
+	nstates() const noexcept
+	{
+		return nresults();
+	}
+
+	inline size_t
+	alignment() const noexcept
+	{
+		return alignment_;
+	}
+
+private:
+	static inline std::vector<jive::port>
+	create_srcports(const ptrtype & dtype, const jive::bittype & ltype, size_t nstates)
+	{
+		std::vector<jive::port> ports({dtype, jive::bittype(8), ltype});
+		std::vector<jive::port> states(nstates, {jive::memtype::instance()});
+		ports.insert(ports.end(), states.begin(), states.end());
+		return ports;
+	}
+
+	size_t alignment_;
+};
+
+static inline std::unique_ptr<jlm::tac>
+create_memset_tac(
+	const variable * destination,
+	const variable * value,
+	const variable * length,
+	size_t alignment,
+	jlm::variable * state)
+{
+	auto dt = dynamic_cast<const jlm::ptrtype*>(&destination->type());
+	if (!dt) throw jlm::error("expected pointer type.");
+
+	auto lt = dynamic_cast<const jive::bittype*>(&length->type());
+	if (!lt) throw jlm::error("expected bits type.");
+
+	jlm::memset_op op(*dt, *lt, 1, alignment);
+	return tac::create(op, {destination, value, length, state}, {state});
+}
+
+static inline std::vector<jive::output*>
+create_memset(
+	jive::output * destination,
+	jive::output * value,
+	jive::output * length,
+	const std::vector<jive::output*> & states,
+	size_t alignment)
+{
+	auto dt = dynamic_cast<const jlm::ptrtype*>(&destination->type());
+	if (!dt) throw jlm::error("expected pointer type.");
+
+	auto lt = dynamic_cast<const jive::bittype*>(&length->type());
+	if (!lt) throw jlm::error("expected bits type.");
+
+	std::vector<jive::output*> operands({destination, value, length});
+	operands.insert(operands.end(), states.begin(), states.end());
+
+	jlm::memset_op op(*dt, *lt, states.size(), alignment);
+	return jive::simple_node::create_normalized(destination->region(), op, operands);
+}
+
+}
+
+#endif
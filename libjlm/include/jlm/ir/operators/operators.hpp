@@ -722,6 +722,16 @@ create_zext_tac(const variable * operand, jlm::variable * result)
 	return tac::create(op, {operand}, {result});
 }
 
+static inline jive::output *
+create_zext(size_t ndstbits, jive::output * operand)
+{
+	auto ot = dynamic_cast<const jive::bittype*>(&operand->type());
+	if (!ot) throw jlm::error("expected bits type.");
+
+	zext_op op(ot->nbits(), ndstbits);
+	return jive::simple_node::create_normalized(operand->region(), op, {operand})[0];
+}
+
 /* floating point constant operator */
 
 class fpconstant_op final : public jive::simple_op {
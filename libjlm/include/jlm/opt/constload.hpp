@@ -0,0 +1,26 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_CONSTLOAD_HPP
+#define JLM_OPT_CONSTLOAD_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Constant load folding
+*
+* Replaces loads from constant globals, possibly through getelementptr operations with
+* constant indices, with a copy of the corresponding value of the global's initializer.
+*/
+void
+fold_constant_loads(jive::graph & rvsdg);
+
+}
+
+#endif
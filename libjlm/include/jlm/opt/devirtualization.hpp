@@ -0,0 +1,28 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_DEVIRTUALIZATION_HPP
+#define JLM_OPT_DEVIRTUALIZATION_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Devirtualization of indirect calls
+*
+* Traces the callees of indirect calls through gamma, theta, and phi nodes, selects,
+* and loads from constant globals. Calls with a single possible target are turned into
+* direct calls, and calls with a small set of targets are turned into a gamma that
+* dispatches to direct calls.
+*/
+void
+devirtualize(jive::graph & rvsdg);
+
+}
+
+#endif
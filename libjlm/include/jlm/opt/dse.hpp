@@ -0,0 +1,27 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_DSE_HPP
+#define JLM_OPT_DSE_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Dead store elimination
+*
+* Removes stores whose value is overwritten on every path before it might be read, as
+* well as stores to non-escaping allocas that are never read afterwards. The memory
+* state is followed through gamma and theta nodes.
+*/
+void
+dse(jive::graph & rvsdg);
+
+}
+
+#endif
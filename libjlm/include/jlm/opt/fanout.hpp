@@ -0,0 +1,50 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_FANOUT_HPP
+#define JLM_OPT_FANOUT_HPP
+
+#include <functional>
+#include <utility>
+
+namespace jive {
+	class graph;
+	class input;
+	class node;
+	class output;
+	class region;
+}
+
+namespace jlm {
+
+/**
+* \brief Load state fan-out
+*
+* Rewrites chains of loads that are serialized through their memory state such that all
+* loads of a chain consume the same state. The states of the loads are joined with a state
+* mux for the consumers of the chain, i.e., the next store or call.
+*/
+void
+fanout_loads(jive::graph & rvsdg);
+
+/*
+	Returns the memory state input and output of a node that only reads memory, or a pair
+	of nullptrs if the node is not a reader.
+*/
+typedef std::function<std::pair<jive::input*, jive::output*>(const jive::node*)> reader_fct;
+
+/**
+* \brief Reader state fan-out
+*
+* Performs the load state fan-out on the nodes of \p region. Besides loads with a single
+* state, all nodes for which \p reader returns a memory state are part of the chains.
+* Subregions are not visited.
+*/
+void
+fanout_readers(jive::region * region, const reader_fct & reader);
+
+}
+
+#endif
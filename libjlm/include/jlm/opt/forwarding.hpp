@@ -0,0 +1,27 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_FORWARDING_HPP
+#define JLM_OPT_FORWARDING_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Store-to-load forwarding
+*
+* Replaces loads with the value of the store that reaches them along the memory state.
+* The state is followed backwards through gamma and theta nodes, and the stored values
+* are routed to the load with new entry, exit, and loop variables.
+*/
+void
+forward_stores(jive::graph & rvsdg);
+
+}
+
+#endif
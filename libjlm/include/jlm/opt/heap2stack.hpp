@@ -0,0 +1,27 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_HEAP2STACK_HPP
+#define JLM_OPT_HEAP2STACK_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Heap-to-stack promotion
+*
+* Replaces calls to malloc with a small constant size by allocas if the returned pointer
+* does not escape the function and is freed in the same region. The corresponding call
+* to free is removed.
+*/
+void
+heap2stack(jive::graph & rvsdg);
+
+}
+
+#endif
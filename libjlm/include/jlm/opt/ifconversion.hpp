@@ -0,0 +1,27 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_IFCONVERSION_HPP
+#define JLM_OPT_IFCONVERSION_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief If-conversion
+*
+* Converts gamma nodes with two cheap and side-effect free subregions into speculated
+* computations and select operations. Select operations whose exclusively used operands
+* are expensive to compute are converted back into gamma nodes.
+*/
+void
+ifconvert(jive::graph & rvsdg);
+
+}
+
+#endif
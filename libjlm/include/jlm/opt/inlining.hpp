@@ -8,10 +8,21 @@
 
 namespace jive {
 	class graph;
+	class output;
+	class region;
 }
 
 namespace jlm {
 
+/**
+* \brief Routes \p output into \p region through the structural nodes in between.
+*
+* The output must be in \p region or one of its ancestors. Returns the output that
+* provides the value in \p region.
+*/
+jive::output *
+route_to_region(jive::output * output, jive::region * region);
+
 void
 inlining(jive::graph & rvsdg);
 
@@ -0,0 +1,27 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_IPCP_HPP
+#define JLM_OPT_IPCP_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Interprocedural constant propagation
+*
+* Substitutes lambda arguments that receive the same constant at every call site. Lambdas
+* that are frequently called with the same combination of constant arguments are
+* specialized for it, and the matching calls are redirected to the specialized copy.
+*/
+void
+ipcp(jive::graph & rvsdg);
+
+}
+
+#endif
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_LOOPDELETION_HPP
+#define JLM_OPT_LOOPDELETION_HPP
+
+namespace jive {
+	class graph;
+	class theta_node;
+}
+
+namespace jlm {
+
+/**
+* \brief Removes a theta node without observable effect.
+*
+* The theta node must have a known number of iterations such that its termination is
+* guaranteed. All users of invariant loop variables, including the loop state, are
+* redirected to the loop inputs. The theta node is removed if none of its outputs are
+* used afterwards.
+*
+* Returns true if the theta node was removed.
+*/
+bool
+delete_loop(jive::theta_node * theta);
+
+void
+delete_loops(jive::graph & rvsdg);
+
+}
+
+#endif
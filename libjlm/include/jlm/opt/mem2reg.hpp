@@ -0,0 +1,28 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_MEM2REG_HPP
+#define JLM_OPT_MEM2REG_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Promotes allocas to values.
+*
+* An alloca is promoted if its address is only used as address operand of loads and
+* stores, possibly routed through gamma entry variables and invariant theta loop
+* variables. The loads and stores are replaced by value flow that follows the memory
+* state through gamma and theta nodes.
+*/
+void
+mem2reg(jive::graph & rvsdg);
+
+}
+
+#endif
@@ -0,0 +1,26 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_MEMEXPAND_HPP
+#define JLM_OPT_MEMEXPAND_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Memcpy and memset expansion
+*
+* Replaces memcpy and memset operations with a small constant length by a sequence of
+* loads and stores.
+*/
+void
+expand_memops(jive::graph & rvsdg);
+
+}
+
+#endif
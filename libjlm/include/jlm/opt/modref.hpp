@@ -0,0 +1,29 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_MODREF_HPP
+#define JLM_OPT_MODREF_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Mod/ref summaries
+*
+* Computes for every lambda whether it reads memory, writes memory, or might not
+* terminate, and rewires the state edges of direct calls accordingly. Calls to functions
+* that neither read nor write memory bypass the memory state, and calls to functions that
+* only read memory share their state with neighbouring loads. Calls to functions without
+* loops or unknown calls bypass the loop state.
+*/
+void
+modref(jive::graph & rvsdg);
+
+}
+
+#endif
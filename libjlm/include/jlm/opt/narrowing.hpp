@@ -0,0 +1,28 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_NARROWING_HPP
+#define JLM_OPT_NARROWING_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Bit-width narrowing
+*
+* Computes the known bits and the demanded bits of bitstring outputs. Masks that only
+* clear known zero or undemanded bits are removed, sign extensions of values with a
+* known zero sign bit become zero extensions, and arithmetic whose result is only
+* demanded in its low bits is performed at a smaller width.
+*/
+void
+narrow(jive::graph & rvsdg);
+
+}
+
+#endif
@@ -13,7 +13,7 @@ namespace jlm {
 class rvsdg;
 class stats_descriptor;
 
-enum class optimization {cne, dne, iln, inv, psh, red, ivt, url, pll};
+enum class optimization {cne, dne, iln, inv, psh, red, ivt, url, pll, usw, ldl, tre, pel, pts, m2r, dse, slf, sra, clf, h2s, lsf, mrs, mex, scp, icp, ras, ifc, vra, nrw, dvt};
 
 void
 optimize(jlm::rvsdg & rvsdg, const optimization & opt);
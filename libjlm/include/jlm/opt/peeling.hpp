@@ -0,0 +1,40 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_PEELING_HPP
+#define JLM_OPT_PEELING_HPP
+
+#include <stddef.h>
+
+namespace jive {
+	class graph;
+	class theta_node;
+}
+
+namespace jlm {
+
+/**
+* \brief Peels off the first \p niterations iterations of a theta node.
+*
+* The iterations are copied in front of the theta node and the remaining loop is
+* guarded by a gamma node for every peeled iteration. Returns the theta node that
+* computes the remaining iterations.
+*/
+jive::theta_node *
+peel(jive::theta_node * theta, size_t niterations);
+
+/**
+* \brief Peels off the first iteration of all theta nodes with loop variables that only
+* differ in the first iteration.
+*
+* The loop variables become invariant in the remaining loop. Theta nodes with more than
+* \p budget nodes are not peeled.
+*/
+void
+peel(jive::graph & rvsdg, size_t budget);
+
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_POINTSTO_HPP
+#define JLM_OPT_POINTSTO_HPP
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace jive {
+	class graph;
+	class node;
+	class output;
+	class region;
+}
+
+namespace jlm {
+
+/**
+* \brief Steensgaard-style points-to analysis.
+*
+* Every pointer is associated with the class of memory locations it might point to.
+* Pointers of unknown origin, e.g., function arguments and call results, as well as
+* pointers that escape to unknown code, point to the unknown class, which might alias
+* with all other classes.
+*/
+class pointsto final {
+public:
+	class location;
+
+	~pointsto();
+
+	pointsto(const pointsto &) = delete;
+
+	pointsto(pointsto &&) = delete;
+
+	pointsto &
+	operator=(const pointsto &) = delete;
+
+	pointsto &
+	operator=(pointsto &&) = delete;
+
+	/**
+	* Returns the class of memory locations \p pointer might point to. Pointers that were
+	* not present at analysis time point to the unknown class.
+	*/
+	const location *
+	memclass(const jive::output * pointer) const;
+
+	bool
+	is_unknown(const location * l) const noexcept;
+
+	bool
+	may_alias(const jive::output * p1, const jive::output * p2) const;
+
+	static std::unique_ptr<pointsto>
+	analyze(const jive::graph & graph);
+
+private:
+	pointsto();
+
+	location *
+	create_location();
+
+	location *
+	lookup(const jive::output * pointer);
+
+	location *
+	target(location * l);
+
+	void
+	unify(location * l1, location * l2);
+
+	void
+	escape(const jive::output * pointer);
+
+	void
+	unify(const jive::output * p1, const jive::output * p2);
+
+	void
+	analyze_simple(const jive::node * node);
+
+	void
+	analyze_structural(const jive::node * node);
+
+	void
+	analyze(const jive::region * region);
+
+	location * unknown_;
+	std::vector<std::unique_ptr<location>> locations_;
+	std::unordered_map<const jive::output*, location*> map_;
+};
+
+/**
+* \brief Splits memory state chains into alias classes.
+*
+* Loads and stores in a region are sequenced only with respect to memory operations of
+* the same alias class. Operations through pointers of the unknown class, calls, and
+* structural nodes join the states of all classes.
+*/
+void
+split_memory_states(jive::graph & rvsdg);
+
+}
+
+#endif
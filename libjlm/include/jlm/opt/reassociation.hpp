@@ -0,0 +1,27 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_REASSOCIATION_HPP
+#define JLM_OPT_REASSOCIATION_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Reassociation
+*
+* Flattens trees of associative and commutative bitstring operations, sorts their
+* operands by rank, folds their constant operands, and rebuilds them as a chain. This
+* gives equivalent expressions the same shape for common node elimination.
+*/
+void
+reassociate(jive::graph & rvsdg);
+
+}
+
+#endif
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_SCCP_HPP
+#define JLM_OPT_SCCP_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Sparse conditional constant propagation
+*
+* Propagates bitstring and control constants through the graph. Gamma alternatives are
+* only considered if their predicate can select them, and theta loop variables are
+* iterated to a fixpoint. Outputs with a constant value are replaced by constants, and
+* gamma and theta nodes with constant predicates are inlined.
+*/
+void
+sccp(jive::graph & rvsdg);
+
+}
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_SRA_HPP
+#define JLM_OPT_SRA_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Scalar replacement of aggregates
+*
+* Splits allocas of struct and array type into one alloca per element if they are only
+* accessed through getelementptr operations with constant indices. The resulting allocas
+* of scalar type can then be promoted by mem2reg().
+*/
+void
+sra(jive::graph & rvsdg);
+
+}
+
+#endif
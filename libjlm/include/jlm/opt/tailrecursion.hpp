@@ -0,0 +1,28 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_TAILRECURSION_HPP
+#define JLM_OPT_TAILRECURSION_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Converts self tail-recursive lambdas into loops.
+*
+* A lambda is considered tail-recursive if all its results originate from a single gamma
+* node, and a call to the lambda itself in one of the gamma's alternatives produces all
+* the results in this alternative. The body of such a lambda is replaced by a theta node
+* that iterates as long as the recursive alternative is taken.
+*/
+void
+eliminate_tail_recursion(jive::graph & rvsdg);
+
+}
+
+#endif
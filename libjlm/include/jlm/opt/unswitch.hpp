@@ -0,0 +1,36 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_UNSWITCH_HPP
+#define JLM_OPT_UNSWITCH_HPP
+
+#include <stddef.h>
+
+namespace jive {
+	class graph;
+	class theta_node;
+}
+
+namespace jlm {
+
+/**
+* \brief Moves a gamma node with a loop invariant predicate out of a theta node.
+*
+* The theta node is replaced by a gamma node that contains a copy of the theta node in
+* each of its subregions. Every copy only comprises the respective alternative of the
+* unswitched gamma node. The transformation is only performed if the number of nodes in
+* the theta node times the number of alternatives does not exceed \p budget.
+*
+* Returns true if the theta node was unswitched.
+*/
+bool
+unswitch(jive::theta_node * theta, size_t budget);
+
+void
+unswitch(jive::graph & rvsdg, size_t budget);
+
+}
+
+#endif
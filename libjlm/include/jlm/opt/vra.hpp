@@ -0,0 +1,28 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#ifndef JLM_OPT_VRA_HPP
+#define JLM_OPT_VRA_HPP
+
+namespace jive {
+	class graph;
+}
+
+namespace jlm {
+
+/**
+* \brief Value range analysis
+*
+* Computes signed intervals for bitstring outputs. The intervals are propagated through
+* arithmetic, refined in gamma alternatives by the predicate, and iterated with widening
+* for theta loop variables. Comparisons that are decided by the intervals are replaced
+* by constants, and impossible alternatives are removed from match operations.
+*/
+void
+vra(jive::graph & rvsdg);
+
+}
+
+#endif
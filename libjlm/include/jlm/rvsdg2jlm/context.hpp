@@ -6,6 +6,7 @@
 namespace jlm {
 
 class cfg_node;
+class lambda_node;
 class module;
 class variable;
 
@@ -14,10 +15,13 @@ namespace rvsdg2jlm {
 class context final {
 public:
 	inline
-	context(jlm::module & module)
+	context(
+		jlm::module & module,
+		std::unordered_map<const lambda_node*, fctattributes> attributes)
 	: cfg_(nullptr)
 	, module_(module)
 	, lpbb_(nullptr)
+	, attributes_(std::move(attributes))
 	{}
 
 	context(const context&) = delete;
@@ -52,6 +56,13 @@ public:
 		return it->second;
 	}
 
+	inline fctattributes
+	attributes(const lambda_node * lambda) const
+	{
+		auto it = attributes_.find(lambda);
+		return it != attributes_.end() ? it->second : fctattributes();
+	}
+
 	inline basic_block *
 	lpbb() const noexcept
 	{
@@ -81,6 +92,7 @@ private:
 	jlm::module & module_;
 	basic_block * lpbb_;
 	std::unordered_map<const jive::output*, const jlm::variable*> ports_;
+	std::unordered_map<const lambda_node*, fctattributes> attributes_;
 };
 
 }}
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/attributes.hpp>
+#include <jlm/ir/operators.hpp>
+
+#include <jive/arch/addresstype.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/phi.h>
+#include <jive/rvsdg/statemux.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+
+namespace jlm {
+
+class attrsummary final {
+public:
+	inline
+	attrsummary(bool ref, bool mod, bool unwind, bool recurse)
+	: ref(ref)
+	, mod(mod)
+	, unwind(unwind)
+	, recurse(recurse)
+	{}
+
+	inline void
+	merge(const attrsummary & other) noexcept
+	{
+		ref = ref || other.ref;
+		mod = mod || other.mod;
+		unwind = unwind || other.unwind;
+		recurse = recurse || other.recurse;
+	}
+
+	inline bool
+	operator==(const attrsummary & other) const noexcept
+	{
+		return ref == other.ref && mod == other.mod
+		    && unwind == other.unwind && recurse == other.recurse;
+	}
+
+	bool ref;
+	bool mod;
+	bool unwind;
+	bool recurse;
+};
+
+typedef std::unordered_map<const lambda_node*, attrsummary> attrsummarymap;
+
+/*
+	Returns the lambda that is called by \p call, or nullptr if it cannot be determined.
+*/
+static const lambda_node *
+callee(const jive::node * call)
+{
+	auto origin = call->input(0)->origin();
+	while (auto argument = dynamic_cast<const jive::argument*>(origin)) {
+		auto node = argument->region()->node();
+		if (!argument->input()) {
+			/* recursion variable */
+			if (!node || !dynamic_cast<const jive::phi_op*>(&node->operation()))
+				return nullptr;
+
+			origin = argument->region()->result(argument->index())->origin();
+			continue;
+		}
+
+		auto theta = dynamic_cast<const jive::theta_node*>(node);
+		if (theta && !jive::is_invariant(theta->output(argument->index())))
+			return nullptr;
+
+		origin = argument->input()->origin();
+	}
+
+	return dynamic_cast<const lambda_node*>(origin->node());
+}
+
+static attrsummary
+summarize(const jive::region * region, const attrsummarymap & summaries)
+{
+	attrsummary s(false, false, false, false);
+	for (const auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<const jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				s.merge(summarize(structnode->subregion(n), summaries));
+			continue;
+		}
+
+		if (is<load_op>(&node)) {
+			s.ref = true;
+		} else if (is<store_op>(&node)) {
+			s.mod = true;
+		} else if (is<call_op>(&node)) {
+			auto lambda = callee(&node);
+			auto it = lambda ? summaries.find(lambda) : summaries.end();
+			s.merge(it != summaries.end() ? it->second : attrsummary(true, true, true, true));
+		} else if (!is<alloca_op>(&node) && !is<jive::mux_op>(&node)) {
+			/* any other operation on memory might read or write it */
+			for (size_t n = 0; n < node.ninputs(); n++) {
+				if (dynamic_cast<const jive::memtype*>(&node.input(n)->type()))
+					s.merge(attrsummary(true, true, false, false));
+			}
+		}
+	}
+
+	return s;
+}
+
+/*
+	The lambdas of a phi node are summarized optimistically and refined until a fixpoint
+	is reached. All of them are considered recursive.
+*/
+static void
+summarize_phi(const jive::structural_node * phi, attrsummarymap & summaries)
+{
+	std::vector<const lambda_node*> lambdas;
+	for (const auto & node : phi->subregion(0)->nodes) {
+		if (auto lambda = dynamic_cast<const lambda_node*>(&node)) {
+			lambdas.push_back(lambda);
+			summaries.insert({lambda, attrsummary(false, false, false, true)});
+		}
+	}
+
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (const auto & lambda : lambdas) {
+			auto s = summarize(lambda->subregion(), summaries);
+			s.recurse = true;
+
+			auto & old = summaries.find(lambda)->second;
+			if (!(s == old)) {
+				old.merge(s);
+				changed = true;
+			}
+		}
+	}
+}
+
+std::unordered_map<const lambda_node*, fctattributes>
+infer_attributes(const jive::graph & rvsdg)
+{
+	attrsummarymap summaries;
+	for (const auto & node : jive::topdown_traverser(rvsdg.root())) {
+		if (auto lambda = dynamic_cast<const lambda_node*>(node)) {
+			summaries.insert({lambda, summarize(lambda->subregion(), summaries)});
+			continue;
+		}
+
+		if (dynamic_cast<const jive::phi_op*>(&node->operation()))
+			summarize_phi(static_cast<const jive::structural_node*>(node), summaries);
+	}
+
+	std::unordered_map<const lambda_node*, fctattributes> attributes;
+	for (const auto & pair : summaries) {
+		auto & s = pair.second;
+
+		fctattributes a;
+		if (!s.ref && !s.mod)
+			a.insert(fctattribute::readnone);
+		else if (!s.mod)
+			a.insert(fctattribute::readonly);
+		if (!s.unwind)
+			a.insert(fctattribute::nounwind);
+		if (!s.recurse)
+			a.insert(fctattribute::norecurse);
+
+		attributes[pair.first] = a;
+	}
+
+	return attributes;
+}
+
+}
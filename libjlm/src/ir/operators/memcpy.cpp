@@ -0,0 +1,69 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/ir/operators/memcpy.hpp>
+
+namespace jlm {
+
+/* memcpy operator */
+
+memcpy_op::~memcpy_op() noexcept
+{}
+
+bool
+memcpy_op::operator==(const operation & other) const noexcept
+{
+	auto op = dynamic_cast<const memcpy_op*>(&other);
+	if (!op || op->narguments() != narguments())
+		return false;
+
+	return op->argument(0) == argument(0)
+	    && op->argument(1) == argument(1)
+	    && op->argument(2) == argument(2)
+	    && op->alignment() == alignment();
+}
+
+std::string
+memcpy_op::debug_string() const
+{
+	return "MEMCPY";
+}
+
+std::unique_ptr<jive::operation>
+memcpy_op::copy() const
+{
+	return std::unique_ptr<jive::operation>(new memcpy_op(*this));
+}
+
+/* memset operator */
+
+memset_op::~memset_op() noexcept
+{}
+
+bool
+memset_op::operator==(const operation & other) const noexcept
+{
+	auto op = dynamic_cast<const memset_op*>(&other);
+	if (!op || op->narguments() != narguments())
+		return false;
+
+	return op->argument(0) == argument(0)
+	    && op->argument(2) == argument(2)
+	    && op->alignment() == alignment();
+}
+
+std::string
+memset_op::debug_string() const
+{
+	return "MEMSET";
+}
+
+std::unique_ptr<jive::operation>
+memset_op::copy() const
+{
+	return std::unique_ptr<jive::operation>(new memset_op(*this));
+}
+
+}
@@ -4,16 +4,30 @@
  */
 
 #include <jlm/ir/operators/operators.hpp>
+#include <jlm/ir/operators/sext.hpp>
 
 #include <jive/arch/addresstype.h>
 #include <jive/types/bitstring/constant.h>
 #include <jive/types/float/flttype.h>
 
+#include <llvm/ADT/APSInt.h>
 #include <llvm/ADT/SmallVector.h>
 #include <llvm/Support/raw_ostream.h>
 
 namespace jlm {
 
+/* cast reductions */
+
+/* a cast whose operand already has the result type */
+static const jive_unop_reduction_path_t cast_reduction_identity = 128;
+
+template<class OP> static inline const OP *
+operand_op(const jive::output * operand)
+{
+	auto node = operand->node();
+	return node ? dynamic_cast<const OP*>(&node->operation()) : nullptr;
+}
+
 /* phi operator */
 
 phi_op::~phi_op() noexcept
@@ -94,6 +108,107 @@ select_op::copy() const
 	return std::unique_ptr<jive::operation>(new select_op(*this));
 }
 
+/* floating point constant folding */
+
+static const llvm::fltSemantics &
+semantics(const fpsize & size)
+{
+	switch (size) {
+		case fpsize::half: return llvm::APFloat::IEEEhalf();
+		case fpsize::flt: return llvm::APFloat::IEEEsingle();
+		case fpsize::dbl: return llvm::APFloat::IEEEdouble();
+		case fpsize::x86fp80: return llvm::APFloat::x87DoubleExtended();
+	}
+
+	JLM_ASSERT(0);
+}
+
+static inline const fpconstant_op *
+fpconstant(const jive::output * output)
+{
+	auto node = producer(output);
+	return node ? dynamic_cast<const fpconstant_op*>(&node->operation()) : nullptr;
+}
+
+static inline const jive::bitconstant_op *
+bitconstant(const jive::output * output)
+{
+	auto node = producer(output);
+	return node ? dynamic_cast<const jive::bitconstant_op*>(&node->operation()) : nullptr;
+}
+
+static inline jive::output *
+create_fpconstant(jive::region * region, const fpsize & size, const llvm::APFloat & constant)
+{
+	fpconstant_op op(size, constant);
+	return jive::simple_node::create_normalized(region, op, {})[0];
+}
+
+static inline bool
+is_fpvalue(const jive::output * output, const llvm::APFloat & value)
+{
+	auto c = fpconstant(output);
+	return c && c->constant().bitwiseIsEqual(value);
+}
+
+static bool
+convert_fp2int(
+	const jive::output * operand,
+	const jive::bittype & type,
+	bool is_signed,
+	llvm::APSInt & result)
+{
+	auto c = fpconstant(operand);
+	if (!c || type.nbits() > 64)
+		return false;
+
+	bool exact;
+	result = llvm::APSInt(type.nbits(), !is_signed);
+	auto status = c->constant().convertToInteger(result, llvm::APFloat::rmTowardZero, &exact);
+	return !(status & llvm::APFloat::opInvalidOp);
+}
+
+/* out of range conversions, including NaNs, are undefined and left alone */
+static inline bool
+is_foldable_fp2int(const jive::output * operand, const jive::bittype & type, bool is_signed)
+{
+	llvm::APSInt result;
+	return convert_fp2int(operand, type, is_signed, result);
+}
+
+static jive::output *
+fold_fp2int(const jive::output * operand, const jive::bittype & type, bool is_signed)
+{
+	llvm::APSInt result;
+	auto foldable = convert_fp2int(operand, type, is_signed, result);
+	JLM_DEBUG_ASSERT(foldable);
+
+	auto value = is_signed ? result.getSExtValue() : result.getZExtValue();
+	return jive::create_bitconstant(operand->region(), type.nbits(), value);
+}
+
+static jive::output *
+fold_int2fp(const jive::output * operand, const fptype & type, bool is_signed)
+{
+	auto c = bitconstant(operand);
+	JLM_DEBUG_ASSERT(c);
+
+	auto & value = c->value();
+	auto v = is_signed ? value.to_int() : value.to_uint();
+	llvm::APInt i(value.nbits(), v, is_signed);
+
+	auto result = llvm::APFloat::getZero(semantics(type.size()));
+	result.convertFromAPInt(i, is_signed, llvm::APFloat::rmNearestTiesToEven);
+	return create_fpconstant(operand->region(), type.size(), result);
+}
+
+static inline bool
+is_foldable_int(const jive::output * operand)
+{
+	auto c = bitconstant(operand);
+	return c && c->value().is_defined() && c->value().nbits() <= 64;
+}
+
 /* fp2ui operator */
 
 fp2ui_op::~fp2ui_op() noexcept
@@ -123,6 +238,10 @@ fp2ui_op::copy() const
 jive_unop_reduction_path_t
 fp2ui_op::can_reduce_operand(const jive::output * operand) const noexcept
 {
+	auto type = static_cast<const jive::bittype*>(&result(0).type());
+	if (is_foldable_fp2int(operand, *type, false))
+		return jive_unop_reduction_constant;
+
 	return jive_unop_reduction_none;
 }
 
@@ -131,7 +250,10 @@ fp2ui_op::reduce_operand(
 	jive_unop_reduction_path_t path,
 	jive::output * operand) const
 {
-	JLM_ASSERT(0);
+	if (path == jive_unop_reduction_constant)
+		return fold_fp2int(operand, *static_cast<const jive::bittype*>(&result(0).type()), false);
+
+	return nullptr;
 }
 
 /* fp2si operator */
@@ -163,6 +285,10 @@ fp2si_op::copy() const
 jive_unop_reduction_path_t
 fp2si_op::can_reduce_operand(const jive::output * operand) const noexcept
 {
+	auto type = static_cast<const jive::bittype*>(&result(0).type());
+	if (is_foldable_fp2int(operand, *type, true))
+		return jive_unop_reduction_constant;
+
 	return jive_unop_reduction_none;
 }
 
@@ -171,7 +297,10 @@ fp2si_op::reduce_operand(
 	jive_unop_reduction_path_t path,
 	jive::output * operand) const
 {
-	JLM_ASSERT(0);
+	if (path == jive_unop_reduction_constant)
+		return fold_fp2int(operand, *static_cast<const jive::bittype*>(&result(0).type()), true);
+
+	return nullptr;
 }
 
 /* ctl2bits operator */
@@ -277,6 +406,14 @@ bits2ptr_op::copy() const
 jive_unop_reduction_path_t
 bits2ptr_op::can_reduce_operand(const jive::output * operand) const noexcept
 {
+	/*
+		The data layout is unknown, so the integer might be narrower than a pointer and
+		truncate it. Only integers of at least 64 bits are assumed to hold any pointer.
+	*/
+	auto op = operand_op<ptr2bits_op>(operand);
+	if (op && op->argument(0) == result(0) && nbits() >= 64)
+		return jive_unop_reduction_inverse;
+
 	return jive_unop_reduction_none;
 }
 
@@ -285,7 +422,10 @@ bits2ptr_op::reduce_operand(
 	jive_unop_reduction_path_t path,
 	jive::output * operand) const
 {
-	JLM_ASSERT(0);
+	if (path == jive_unop_reduction_inverse)
+		return operand->node()->input(0)->origin();
+
+	return nullptr;
 }
 
 /* ptr2bits operator */
@@ -317,6 +457,10 @@ ptr2bits_op::copy() const
 jive_unop_reduction_path_t
 ptr2bits_op::can_reduce_operand(const jive::output * operand) const noexcept
 {
+	auto op = operand_op<bits2ptr_op>(operand);
+	if (op && op->argument(0) == result(0))
+		return jive_unop_reduction_inverse;
+
 	return jive_unop_reduction_none;
 }
 
@@ -325,7 +469,10 @@ ptr2bits_op::reduce_operand(
 	jive_unop_reduction_path_t path,
 	jive::output * operand) const
 {
-	JLM_ASSERT(0);
+	if (path == jive_unop_reduction_inverse)
+		return operand->node()->input(0)->origin();
+
+	return nullptr;
 }
 
 /* data array constant operator */
@@ -431,6 +578,12 @@ zext_op::can_reduce_operand(const jive::output * operand) const noexcept
 	if (jive::is<jive::bitconstant_op>(producer(operand)))
 		return jive_unop_reduction_constant;
 
+	if (nsrcbits() == ndstbits())
+		return cast_reduction_identity;
+
+	if (operand_op<zext_op>(operand))
+		return jive_unop_reduction_merge;
+
 	return jive_unop_reduction_none;
 }
 
@@ -444,6 +597,13 @@ zext_op::reduce_operand(
 		return create_bitconstant(operand->node()->region(), c->value().zext(ndstbits()-nsrcbits()));
 	}
 
+	if (path == cast_reduction_identity)
+		return operand;
+
+	/* zext(zext(x)) -> zext(x) */
+	if (path == jive_unop_reduction_merge)
+		return create_zext(ndstbits(), operand->node()->input(0)->origin());
+
 	return nullptr;
 }
 
@@ -520,6 +680,9 @@ fpcmp_op::can_reduce_operand_pair(
 	const jive::output * op1,
 	const jive::output * op2) const noexcept
 {
+	if (fpconstant(op1) && fpconstant(op2))
+		return jive_binop_reduction_constants;
+
 	return jive_binop_reduction_none;
 }
 
@@ -529,7 +692,29 @@ fpcmp_op::reduce_operand_pair(
 	jive::output * op1,
 	jive::output * op2) const
 {
-	JLM_ASSERT(0);
+	if (path != jive_binop_reduction_constants)
+		return nullptr;
+
+	/* the outcomes of the comparison for which a predicate holds */
+	enum {lt = 1, eq = 2, gt = 4, un = 8};
+	static std::unordered_map<fpcmp, size_t> map({
+	  {fpcmp::TRUE, lt | eq | gt | un}, {fpcmp::FALSE, 0}
+	, {fpcmp::oeq, eq}, {fpcmp::ogt, gt}, {fpcmp::oge, gt | eq}, {fpcmp::olt, lt}
+	, {fpcmp::ole, lt | eq}, {fpcmp::one, lt | gt}, {fpcmp::ord, lt | eq | gt}
+	, {fpcmp::ueq, un | eq}, {fpcmp::ugt, un | gt}, {fpcmp::uge, un | gt | eq}
+	, {fpcmp::ult, un | lt}, {fpcmp::ule, un | lt | eq}, {fpcmp::une, un | lt | gt}
+	, {fpcmp::uno, un}
+	});
+
+	static std::unordered_map<llvm::APFloat::cmpResult, size_t> outcomes({
+	  {llvm::APFloat::cmpLessThan, lt}, {llvm::APFloat::cmpEqual, eq}
+	, {llvm::APFloat::cmpGreaterThan, gt}, {llvm::APFloat::cmpUnordered, un}
+	});
+
+	auto r = fpconstant(op1)->constant().compare(fpconstant(op2)->constant());
+
+	JLM_DEBUG_ASSERT(map.find(cmp()) != map.end());
+	return jive::create_bitconstant(op1->region(), 1, (map[cmp()] & outcomes[r]) != 0);
 }
 
 /* undef constant operator */
@@ -591,6 +776,33 @@ fpbin_op::can_reduce_operand_pair(
 	const jive::output * op1,
 	const jive::output * op2) const noexcept
 {
+	if (fpconstant(op1) && fpconstant(op2))
+		return jive_binop_reduction_constants;
+
+	/*
+		Only identities that hold for signed zeros are applied:
+		x + -0.0, x - +0.0, x * 1.0, and x / 1.0
+	*/
+	auto & s = semantics(size());
+	llvm::APFloat one(s, 1);
+	auto pzero = llvm::APFloat::getZero(s, false);
+	auto nzero = llvm::APFloat::getZero(s, true);
+
+	if (fpop() == fpop::add && is_fpvalue(op2, nzero))
+		return jive_binop_reduction_rneutral;
+
+	if (fpop() == fpop::add && is_fpvalue(op1, nzero))
+		return jive_binop_reduction_lneutral;
+
+	if (fpop() == fpop::sub && is_fpvalue(op2, pzero))
+		return jive_binop_reduction_rneutral;
+
+	if ((fpop() == fpop::mul || fpop() == fpop::div) && is_fpvalue(op2, one))
+		return jive_binop_reduction_rneutral;
+
+	if (fpop() == fpop::mul && is_fpvalue(op1, one))
+		return jive_binop_reduction_lneutral;
+
 	return jive_binop_reduction_none;
 }
 
@@ -600,7 +812,26 @@ fpbin_op::reduce_operand_pair(
 	jive::output * op1,
 	jive::output * op2) const
 {
-	JLM_ASSERT(0);
+	if (path == jive_binop_reduction_rneutral)
+		return op1;
+
+	if (path == jive_binop_reduction_lneutral)
+		return op2;
+
+	if (path != jive_binop_reduction_constants)
+		return nullptr;
+
+	auto result = fpconstant(op1)->constant();
+	auto & c2 = fpconstant(op2)->constant();
+	switch (fpop()) {
+		case fpop::add: result.add(c2, llvm::APFloat::rmNearestTiesToEven); break;
+		case fpop::sub: result.subtract(c2, llvm::APFloat::rmNearestTiesToEven); break;
+		case fpop::mul: result.multiply(c2, llvm::APFloat::rmNearestTiesToEven); break;
+		case fpop::div: result.divide(c2, llvm::APFloat::rmNearestTiesToEven); break;
+		case fpop::mod: result.mod(c2); break;
+	}
+
+	return create_fpconstant(op1->region(), size(), result);
 }
 
 /* fpext operator */
@@ -630,6 +861,9 @@ fpext_op::copy() const
 jive_unop_reduction_path_t
 fpext_op::can_reduce_operand(const jive::output * operand) const noexcept
 {
+	if (fpconstant(operand))
+		return jive_unop_reduction_constant;
+
 	return jive_unop_reduction_none;
 }
 
@@ -638,7 +872,13 @@ fpext_op::reduce_operand(
 	jive_unop_reduction_path_t path,
 	jive::output * operand) const
 {
-	JLM_ASSERT(0);
+	if (path != jive_unop_reduction_constant)
+		return nullptr;
+
+	bool loses_info;
+	auto result = fpconstant(operand)->constant();
+	result.convert(semantics(dstsize()), llvm::APFloat::rmNearestTiesToEven, &loses_info);
+	return create_fpconstant(operand->region(), dstsize(), result);
 }
 
 /* fptrunc operator */
@@ -668,6 +908,9 @@ fptrunc_op::copy() const
 jive_unop_reduction_path_t
 fptrunc_op::can_reduce_operand(const jive::output * operand) const noexcept
 {
+	if (fpconstant(operand))
+		return jive_unop_reduction_constant;
+
 	return jive_unop_reduction_none;
 }
 
@@ -676,7 +919,13 @@ fptrunc_op::reduce_operand(
 	jive_unop_reduction_path_t path,
 	jive::output * operand) const
 {
-	JLM_ASSERT(0);
+	if (path != jive_unop_reduction_constant)
+		return nullptr;
+
+	bool loses_info;
+	auto result = fpconstant(operand)->constant();
+	result.convert(semantics(dstsize()), llvm::APFloat::rmNearestTiesToEven, &loses_info);
+	return create_fpconstant(operand->region(), dstsize(), result);
 }
 
 /* valist operator */
@@ -741,6 +990,12 @@ bitcast_op::copy() const
 jive_unop_reduction_path_t
 bitcast_op::can_reduce_operand(const jive::output * operand) const noexcept
 {
+	if (argument(0) == result(0))
+		return cast_reduction_identity;
+
+	if (operand_op<bitcast_op>(operand))
+		return jive_unop_reduction_merge;
+
 	return jive_unop_reduction_none;
 }
 
@@ -749,7 +1004,18 @@ bitcast_op::reduce_operand(
 	jive_unop_reduction_path_t path,
 	jive::output * operand) const
 {
-	JLM_ASSERT(0);
+	if (path == cast_reduction_identity)
+		return operand;
+
+	/* bitcast(bitcast(x)) -> bitcast(x) */
+	if (path == jive_unop_reduction_merge) {
+		auto origin = operand->node()->input(0)->origin();
+		auto & type = *static_cast<const jive::valuetype*>(&result(0).type());
+		bitcast_op op(*static_cast<const jive::valuetype*>(&origin->type()), type);
+		return jive::simple_node::create_normalized(operand->region(), op, {origin})[0];
+	}
+
+	return nullptr;
 }
 
 /* struct constant operator */
@@ -805,6 +1071,17 @@ trunc_op::copy() const
 jive_unop_reduction_path_t
 trunc_op::can_reduce_operand(const jive::output * operand) const noexcept
 {
+	if (jive::is<jive::bitconstant_op>(producer(operand)))
+		return jive_unop_reduction_constant;
+
+	if (nsrcbits() == ndstbits())
+		return cast_reduction_identity;
+
+	if (operand_op<trunc_op>(operand)
+	|| operand_op<zext_op>(operand)
+	|| operand_op<sext_op>(operand))
+		return jive_unop_reduction_merge;
+
 	return jive_unop_reduction_none;
 }
 
@@ -813,7 +1090,33 @@ trunc_op::reduce_operand(
 	jive_unop_reduction_path_t path,
 	jive::output * operand) const
 {
-	JLM_ASSERT(0);
+	if (path == jive_unop_reduction_constant) {
+		auto c = static_cast<const jive::bitconstant_op*>(&producer(operand)->operation());
+		return create_bitconstant(operand->region(), c->value().slice(0, ndstbits()));
+	}
+
+	if (path == cast_reduction_identity)
+		return operand;
+
+	if (path != jive_unop_reduction_merge)
+		return nullptr;
+
+	/*
+		trunc(trunc(x)) -> trunc(x)
+		trunc(ext(x)) -> x, ext(x), or trunc(x) depending on the width of x
+	*/
+	auto origin = operand->node()->input(0)->origin();
+	auto nbits = static_cast<const jive::bittype*>(&origin->type())->nbits();
+	if (operand_op<trunc_op>(operand) || nbits > ndstbits())
+		return create_trunc(ndstbits(), origin);
+
+	if (nbits == ndstbits())
+		return origin;
+
+	if (operand_op<zext_op>(operand))
+		return create_zext(ndstbits(), origin);
+
+	return create_sext(ndstbits(), origin);
 }
 
 
@@ -847,6 +1150,9 @@ jive_unop_reduction_path_t
 uitofp_op::can_reduce_operand(
 	const jive::output * operand) const noexcept
 {
+	if (is_foldable_int(operand))
+		return jive_unop_reduction_constant;
+
 	return jive_unop_reduction_none;
 }
 
@@ -855,7 +1161,10 @@ uitofp_op::reduce_operand(
 	jive_unop_reduction_path_t path,
 	jive::output * operand) const
 {
-	JLM_ASSERT(0);
+	if (path == jive_unop_reduction_constant)
+		return fold_int2fp(operand, *static_cast<const fptype*>(&result(0).type()), false);
+
+	return nullptr;
 }
 
 /* sitofp operator */
@@ -887,6 +1196,9 @@ sitofp_op::copy() const
 jive_unop_reduction_path_t
 sitofp_op::can_reduce_operand(const jive::output * operand) const noexcept
 {
+	if (is_foldable_int(operand))
+		return jive_unop_reduction_constant;
+
 	return jive_unop_reduction_none;
 }
 
@@ -895,7 +1207,10 @@ sitofp_op::reduce_operand(
 	jive_unop_reduction_path_t path,
 	jive::output * operand) const
 {
-	JLM_ASSERT(0);
+	if (path == jive_unop_reduction_constant)
+		return fold_int2fp(operand, *static_cast<const fptype*>(&result(0).type()), true);
+
+	return nullptr;
 }
 
 /* constant array operator */
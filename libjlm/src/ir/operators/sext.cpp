@@ -25,6 +25,16 @@ is_bitbinary_reducible(const jive::output * operand)
 	return jive::is<jive::bitbinary_op>(operand->node());
 }
 
+static bool
+is_merge_reducible(const jive::output * operand)
+{
+	if (!operand->node())
+		return false;
+
+	auto & op = operand->node()->operation();
+	return dynamic_cast<const sext_op*>(&op) || dynamic_cast<const zext_op*>(&op);
+}
+
 static bool
 is_inverse_reducible(const sext_op & op, const jive::output * operand)
 {
@@ -62,6 +72,27 @@ perform_bitbinary_reduction(const sext_op & op, jive::output * operand)
 	return jive::simple_node::create_normalized(region, *bop->create(op.ndstbits()), {op1, op2})[0];
 }
 
+/*
+	sext(sext(x)) -> sext(x)
+	sext(zext(x)) -> zext(x)
+*/
+static jive::output *
+perform_merge_reduction(const sext_op & op, jive::output * operand)
+{
+	JLM_DEBUG_ASSERT(is_merge_reducible(operand));
+	auto origin = operand->node()->input(0)->origin();
+
+	if (dynamic_cast<const sext_op*>(&operand->node()->operation()))
+		return create_sext(op.ndstbits(), origin);
+
+	/* the sign bit of a strict zero extension is zero */
+	auto zop = static_cast<const zext_op*>(&operand->node()->operation());
+	if (zop->nsrcbits() == zop->ndstbits())
+		return create_sext(op.ndstbits(), origin);
+
+	return create_zext(op.ndstbits(), origin);
+}
+
 static jive::output *
 perform_inverse_reduction(const sext_op & op, jive::output * operand)
 {
@@ -108,6 +139,9 @@ sext_op::can_reduce_operand(const jive::output * operand) const noexcept
 	if (is_inverse_reducible(*this, operand))
 		return jive_unop_reduction_inverse;
 
+	if (is_merge_reducible(operand))
+		return jive_unop_reduction_merge;
+
 	return jive_unop_reduction_none;
 }
 
@@ -130,6 +164,9 @@ sext_op::reduce_operand(
 	if (path == jive_unop_reduction_inverse)
 		return perform_inverse_reduction(*this, operand);
 
+	if (path == jive_unop_reduction_merge)
+		return perform_merge_reduction(*this, operand);
+
 	return nullptr;
 }
 
@@ -188,7 +188,18 @@ convert_call(
 		operands.push_back(ctx.value(argument));
 	}
 
-	return builder.CreateCall(function, operands);
+	auto call = builder.CreateCall(function, operands);
+
+	/* direct calls carry the attributes of their callee */
+	if (auto f = llvm::dyn_cast<llvm::Function>(function)) {
+		for (auto kind : {llvm::Attribute::ReadNone, llvm::Attribute::ReadOnly,
+		llvm::Attribute::NoUnwind, llvm::Attribute::NoRecurse}) {
+			if (f->hasFnAttribute(kind))
+				call->addAttribute(llvm::AttributeList::FunctionIndex, kind);
+		}
+	}
+
+	return call;
 }
 
 static inline bool
@@ -286,6 +297,37 @@ convert_store(
 	return nullptr;
 }
 
+static inline llvm::Value *
+convert_memcpy(
+	const jive::simple_op & op,
+	const std::vector<const variable*> & args,
+	llvm::IRBuilder<> & builder,
+	context & ctx)
+{
+	JLM_DEBUG_ASSERT(is<memcpy_op>(op) && args.size() >= 3);
+	auto mop = static_cast<const memcpy_op*>(&op);
+
+	auto alignment = mop->alignment();
+	builder.CreateMemCpy(ctx.value(args[0]), alignment, ctx.value(args[1]), alignment,
+		ctx.value(args[2]));
+	return nullptr;
+}
+
+static inline llvm::Value *
+convert_memset(
+	const jive::simple_op & op,
+	const std::vector<const variable*> & args,
+	llvm::IRBuilder<> & builder,
+	context & ctx)
+{
+	JLM_DEBUG_ASSERT(is<memset_op>(op) && args.size() >= 3);
+	auto mop = static_cast<const memset_op*>(&op);
+
+	builder.CreateMemSet(ctx.value(args[0]), ctx.value(args[1]), ctx.value(args[2]),
+		mop->alignment());
+	return nullptr;
+}
+
 static inline llvm::Value *
 convert_alloca(
 	const jive::simple_op & op,
@@ -776,6 +818,8 @@ convert_operation(
 	, {std::type_index(typeid(jlm::phi_op)), convert_phi}
 	, {std::type_index(typeid(jlm::load_op)), convert_load}
 	, {std::type_index(typeid(jlm::store_op)), convert_store}
+	, {std::type_index(typeid(jlm::memcpy_op)), convert_memcpy}
+	, {std::type_index(typeid(jlm::memset_op)), convert_memset}
 	, {std::type_index(typeid(jlm::alloca_op)), convert_alloca}
 	, {typeid(jlm::getelementptr_op), convert_getelementptr}
 	, {std::type_index(typeid(jlm::data_array_constant_op)), convert_data_array_constant}
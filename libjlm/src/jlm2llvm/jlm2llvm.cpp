@@ -298,6 +298,22 @@ convert_linkage(const jlm::linkage & linkage)
 	return map[linkage];
 }
 
+static void
+convert_attributes(const fctattributes & attributes, llvm::Function & f)
+{
+	static std::unordered_map<fctattribute, llvm::Attribute::AttrKind> map({
+	  {fctattribute::readnone, llvm::Attribute::ReadNone}
+	, {fctattribute::readonly, llvm::Attribute::ReadOnly}
+	, {fctattribute::nounwind, llvm::Attribute::NoUnwind}
+	, {fctattribute::norecurse, llvm::Attribute::NoRecurse}
+	});
+
+	for (const auto & pair : map) {
+		if (attributes.contains(pair.first))
+			f.addFnAttr(pair.second);
+	}
+}
+
 static void
 convert_ipgraph(const jlm::ipgraph & clg, context & ctx)
 {
@@ -320,6 +336,7 @@ convert_ipgraph(const jlm::ipgraph & clg, context & ctx)
 			auto type = convert_type(n->fcttype(), ctx);
 			auto linkage = convert_linkage(n->linkage());
 			auto f = llvm::Function::Create(type, linkage, n->name(), &lm);
+			convert_attributes(n->attributes(), *f);
 			ctx.insert(v, f);
 		} else
 			JLM_ASSERT(0);
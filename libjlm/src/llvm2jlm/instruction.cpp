@@ -26,6 +26,7 @@
 
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
 #include <llvm/IR/Function.h>
 
 #include <typeindex>
@@ -304,12 +305,46 @@ convert_getelementptr_instruction(llvm::Instruction * inst, tacsvector_t & tacs,
 	return tacs.back()->output(0);
 }
 
+static inline const variable *
+convert_memcpy_instruction(llvm::MemCpyInst * i, tacsvector_t & tacs, context & ctx)
+{
+	auto destination = convert_value(i->getDest(), tacs, ctx);
+	auto source = convert_value(i->getSource(), tacs, ctx);
+	auto length = convert_value(i->getLength(), tacs, ctx);
+	auto alignment = std::max(std::min(i->getDestAlignment(), i->getSourceAlignment()), 1u);
+
+	tacs.push_back(create_memcpy_tac(destination, source, length, alignment, ctx.memory_state()));
+	return nullptr;
+}
+
+static inline const variable *
+convert_memset_instruction(llvm::MemSetInst * i, tacsvector_t & tacs, context & ctx)
+{
+	auto destination = convert_value(i->getDest(), tacs, ctx);
+	auto value = convert_value(i->getValue(), tacs, ctx);
+	auto length = convert_value(i->getLength(), tacs, ctx);
+	auto alignment = std::max(i->getDestAlignment(), 1u);
+
+	tacs.push_back(create_memset_tac(destination, value, length, alignment, ctx.memory_state()));
+	return nullptr;
+}
+
 static inline const variable *
 convert_call_instruction(llvm::Instruction * instruction, tacsvector_t & tacs, context & ctx)
 {
 	JLM_DEBUG_ASSERT(instruction->getOpcode() == llvm::Instruction::Call);
 	auto i = llvm::cast<llvm::CallInst>(instruction);
 
+	/* memcpy and memset intrinsics have dedicated operators */
+	if (auto mi = llvm::dyn_cast<llvm::MemCpyInst>(i)) {
+		if (!mi->isVolatile())
+			return convert_memcpy_instruction(mi, tacs, ctx);
+	}
+	if (auto mi = llvm::dyn_cast<llvm::MemSetInst>(i)) {
+		if (!mi->isVolatile())
+			return convert_memset_instruction(mi, tacs, ctx);
+	}
+
 	auto f = i->getCalledValue();
 	/* FIXME: currently needed to insert edge in call graph */
 	convert_value(f, tacs, ctx);
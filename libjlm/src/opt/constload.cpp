@@ -0,0 +1,249 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/constload.hpp>
+
+#include <jive/rvsdg/phi.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/bitstring/constant.h>
+
+#ifdef CLFTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+static bool
+is_constant(const jive::output * output, size_t & value)
+{
+	if (!jive::is<jive::bitconstant_op>(output->node()))
+		return false;
+
+	auto op = static_cast<const jive::bitconstant_op*>(&output->node()->operation());
+	if (!op->value().is_defined())
+		return false;
+
+	value = op->value().to_uint();
+	return true;
+}
+
+/*
+	Follows the address back to a delta node. The element indices of all getelementptr
+	operations on the way are collected in \p path.
+*/
+static const delta_node *
+trace_global(const jive::output * address, std::vector<size_t> & path)
+{
+	while (true) {
+		auto node = address->node();
+		if (auto delta = dynamic_cast<const delta_node*>(node))
+			return delta;
+
+		if (is<getelementptr_op>(node)) {
+			std::vector<size_t> indices;
+			for (size_t n = 1; n < node->ninputs(); n++) {
+				size_t index;
+				if (!is_constant(node->input(n)->origin(), index))
+					return nullptr;
+				indices.push_back(index);
+			}
+
+			if (indices.empty() || indices[0] != 0)
+				return nullptr;
+
+			path.insert(path.begin(), std::next(indices.begin()), indices.end());
+			address = node->input(0)->origin();
+			continue;
+		}
+
+		auto argument = dynamic_cast<const jive::argument*>(address);
+		if (!argument || !argument->region()->node())
+			return nullptr;
+
+		node = argument->region()->node();
+		if (argument->input()) {
+			auto theta = dynamic_cast<const jive::theta_node*>(node);
+			if (theta && !jive::is_invariant(theta->output(argument->index())))
+				return nullptr;
+
+			address = argument->input()->origin();
+			continue;
+		}
+
+		/* recursion variable */
+		if (dynamic_cast<const jive::phi_op*>(&node->operation())) {
+			address = argument->region()->result(argument->index())->origin();
+			continue;
+		}
+
+		return nullptr;
+	}
+}
+
+static const jive::type *
+element_type(const jive::type & type, size_t index)
+{
+	if (auto at = dynamic_cast<const arraytype*>(&type))
+		return index < at->nelements() ? &at->element_type() : nullptr;
+
+	auto st = dynamic_cast<const structtype*>(&type);
+	if (st && index < st->declaration()->nelements())
+		return &st->declaration()->element(index);
+
+	return nullptr;
+}
+
+static jive::output *
+create_zero(jive::region * region, const jive::type & type)
+{
+	if (auto bt = dynamic_cast<const jive::bittype*>(&type))
+		return jive::create_bitconstant(region, bt->nbits(), 0);
+
+	if (auto pt = dynamic_cast<const ptrtype*>(&type)) {
+		ptr_constant_null_op op(*pt);
+		return jive::simple_node::create_normalized(region, op, {})[0];
+	}
+
+	if (dynamic_cast<const arraytype*>(&type) || dynamic_cast<const structtype*>(&type)) {
+		constant_aggregate_zero_op op(type);
+		return jive::simple_node::create_normalized(region, op, {})[0];
+	}
+
+	return nullptr;
+}
+
+/*
+	Copies the expression that computes \p value to \p region. Returns nullptr if the
+	expression depends on region arguments.
+*/
+static jive::output *
+copy_constant(const jive::output * value, jive::region * region)
+{
+	auto node = value->node();
+	if (!dynamic_cast<const jive::simple_node*>(node))
+		return nullptr;
+
+	std::vector<jive::output*> operands;
+	for (size_t n = 0; n < node->ninputs(); n++) {
+		auto operand = copy_constant(node->input(n)->origin(), region);
+		if (!operand)
+			return nullptr;
+		operands.push_back(operand);
+	}
+
+	return node->copy(region, operands)->output(value->index());
+}
+
+/*
+	Returns the value of the initializer at \p path as a constant in \p region, or nullptr
+	if it cannot be determined or is not of type \p type.
+*/
+static jive::output *
+resolve(
+	const delta_node * delta,
+	const std::vector<size_t> & path,
+	const jive::type & type,
+	jive::region * region)
+{
+	auto value = delta->subregion()->result(0)->origin();
+
+	for (size_t n = 0; n < path.size(); n++) {
+		auto node = value->node();
+		if (is<constant_aggregate_zero_op>(node)) {
+			/* the remaining path only selects the element type */
+			const jive::type * t = &value->type();
+			for (size_t i = n; i < path.size() && t; i++)
+				t = element_type(*t, path[i]);
+
+			return t && *t == type ? create_zero(region, type) : nullptr;
+		}
+
+		if (!is<data_array_constant_op>(node)
+		&& !is<constant_array_op>(node)
+		&& !is<struct_constant_op>(node))
+			return nullptr;
+
+		if (path[n] >= node->ninputs())
+			return nullptr;
+
+		value = node->input(path[n])->origin();
+	}
+
+	if (value->type() != type)
+		return nullptr;
+
+	return copy_constant(value, region);
+}
+
+static void
+fold_load(jive::node * load)
+{
+	std::vector<size_t> path;
+	auto delta = trace_global(load->input(0)->origin(), path);
+	if (!delta || !delta->constant())
+		return;
+
+	auto value = resolve(delta, path, load->output(0)->type(), load->region());
+	if (!value)
+		return;
+
+	load->output(0)->divert_users(value);
+	for (size_t n = 1; n < load->noutputs(); n++)
+		load->output(n)->divert_users(load->input(n)->origin());
+	remove(load);
+}
+
+static void
+collect_loads(jive::region * region, std::vector<jive::node*> & loads)
+{
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				collect_loads(structnode->subregion(n), loads);
+			continue;
+		}
+
+		if (is<load_op>(&node))
+			loads.push_back(&node);
+	}
+}
+
+static void
+fold_constant_loads(jive::region * region)
+{
+	std::vector<jive::node*> loads;
+	collect_loads(region, loads);
+
+	for (const auto & load : loads)
+		fold_load(load);
+}
+
+void
+fold_constant_loads(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef CLFTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	fold_constant_loads(root);
+
+	#ifdef CLFTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "CLFTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
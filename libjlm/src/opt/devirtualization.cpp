@@ -0,0 +1,446 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/devirtualization.hpp>
+#include <jlm/opt/inlining.hpp>
+
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/phi.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/bitstring/constant.h>
+
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef DVTTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+/* maximum number of targets for which a dispatch gamma is created */
+static const size_t max_targets = 4;
+
+/* element index of a getelementptr operation that is not a constant */
+static const size_t any_index = std::numeric_limits<size_t>::max();
+
+static inline bool
+is_phi(const jive::node * node)
+{
+	return node && dynamic_cast<const jive::phi_op*>(&node->operation());
+}
+
+static inline bool
+is_theta_variant(const jive::argument * argument)
+{
+	auto theta = dynamic_cast<const jive::theta_node*>(argument->region()->node());
+	return theta && !jive::is_invariant(theta->output(argument->index()));
+}
+
+/*
+	Returns true if \p callee is a function that is only routed to the call through
+	region arguments, i.e., the call is already direct.
+*/
+static bool
+is_direct(const jive::output * callee)
+{
+	while (auto argument = dynamic_cast<const jive::argument*>(callee)) {
+		if (!argument->input())
+			return is_phi(argument->region()->node());
+
+		if (is_theta_variant(argument))
+			return false;
+
+		callee = argument->input()->origin();
+	}
+
+	return dynamic_cast<const lambda_node*>(callee->node()) != nullptr;
+}
+
+class targets final {
+public:
+	inline void
+	insert(const lambda_node * lambda)
+	{
+		if (set_.insert(lambda).second)
+			lambdas_.push_back(lambda);
+	}
+
+	inline bool
+	visit(const jive::output * output)
+	{
+		return visited_.insert(output).second;
+	}
+
+	inline const std::vector<const lambda_node*> &
+	lambdas() const noexcept
+	{
+		return lambdas_;
+	}
+
+private:
+	std::vector<const lambda_node*> lambdas_;
+	std::unordered_set<const lambda_node*> set_;
+	std::unordered_set<const jive::output*> visited_;
+};
+
+static bool
+collect(const jive::output * output, targets & ts);
+
+/*
+	Follows the address back to a constant delta node. The element indices of all
+	getelementptr operations on the way are collected in \p path, where non-constant
+	indices are recorded as any_index.
+*/
+static const delta_node *
+trace_global(const jive::output * address, std::vector<size_t> & path)
+{
+	while (true) {
+		auto node = address->node();
+		if (auto delta = dynamic_cast<const delta_node*>(node))
+			return delta->constant() ? delta : nullptr;
+
+		if (is<getelementptr_op>(node)) {
+			std::vector<size_t> indices;
+			for (size_t n = 1; n < node->ninputs(); n++) {
+				auto origin = node->input(n)->origin();
+				if (!jive::is<jive::bitconstant_op>(origin->node())) {
+					indices.push_back(any_index);
+					continue;
+				}
+
+				auto op = static_cast<const jive::bitconstant_op*>(&origin->node()->operation());
+				indices.push_back(op->value().is_defined() ? op->value().to_uint() : any_index);
+			}
+
+			if (indices.empty() || indices[0] != 0)
+				return nullptr;
+
+			path.insert(path.begin(), std::next(indices.begin()), indices.end());
+			address = node->input(0)->origin();
+			continue;
+		}
+
+		auto argument = dynamic_cast<const jive::argument*>(address);
+		if (!argument || !argument->region()->node())
+			return nullptr;
+
+		if (argument->input()) {
+			if (is_theta_variant(argument))
+				return nullptr;
+
+			address = argument->input()->origin();
+			continue;
+		}
+
+		/* recursion variable */
+		if (is_phi(argument->region()->node())) {
+			address = argument->region()->result(argument->index())->origin();
+			continue;
+		}
+
+		return nullptr;
+	}
+}
+
+/*
+	Collects the targets of all values of the initializer of \p delta at \p path.
+*/
+static bool
+collect_initializer(const jive::output * value, const std::vector<size_t> & path, size_t n,
+	targets & ts)
+{
+	if (n == path.size())
+		return collect(value, ts);
+
+	auto node = value->node();
+	if (is<constant_aggregate_zero_op>(node))
+		return true;
+
+	if (!is<data_array_constant_op>(node)
+	&& !is<constant_array_op>(node)
+	&& !is<struct_constant_op>(node))
+		return false;
+
+	if (path[n] != any_index) {
+		if (path[n] >= node->ninputs())
+			return false;
+
+		return collect_initializer(node->input(path[n])->origin(), path, n+1, ts);
+	}
+
+	for (size_t i = 0; i < node->ninputs(); i++) {
+		if (!collect_initializer(node->input(i)->origin(), path, n+1, ts))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+	Collects all functions \p output can evaluate to. Returns false if not all of them
+	are known.
+*/
+static bool
+collect(const jive::output * output, targets & ts)
+{
+	if (!ts.visit(output))
+		return true;
+
+	if (auto argument = dynamic_cast<const jive::argument*>(output)) {
+		auto node = argument->region()->node();
+		if (!node)
+			return false;
+
+		if (argument->input()) {
+			if (is_theta_variant(argument)
+			&& !collect(argument->region()->result(argument->index()+1)->origin(), ts))
+				return false;
+
+			return collect(argument->input()->origin(), ts);
+		}
+
+		/* recursion variable */
+		if (is_phi(node))
+			return collect(argument->region()->result(argument->index())->origin(), ts);
+
+		return false;
+	}
+
+	auto node = output->node();
+	if (auto lambda = dynamic_cast<const lambda_node*>(node)) {
+		ts.insert(lambda);
+		return true;
+	}
+
+	/* calling a null pointer is undefined */
+	if (is<ptr_constant_null_op>(node))
+		return true;
+
+	if (auto gamma = dynamic_cast<const jive::gamma_node*>(node)) {
+		for (size_t n = 0; n < gamma->nsubregions(); n++) {
+			if (!collect(gamma->subregion(n)->result(output->index())->origin(), ts))
+				return false;
+		}
+		return true;
+	}
+
+	if (auto theta = dynamic_cast<const jive::theta_node*>(node))
+		return collect(theta->subregion()->argument(output->index()), ts);
+
+	if (is_phi(node)) {
+		auto soutput = static_cast<const jive::structural_output*>(output);
+		return collect(soutput->results.first()->origin(), ts);
+	}
+
+	if (is<select_op>(node))
+		return collect(node->input(1)->origin(), ts) && collect(node->input(2)->origin(), ts);
+
+	if (is<load_op>(node) && output->index() == 0) {
+		std::vector<size_t> path;
+		auto delta = trace_global(node->input(0)->origin(), path);
+		if (!delta)
+			return false;
+
+		return collect_initializer(delta->subregion()->result(0)->origin(), path, 0, ts);
+	}
+
+	return false;
+}
+
+static bool
+is_ancestor(const jive::region * ancestor, const jive::region * region)
+{
+	while (region) {
+		if (region == ancestor)
+			return true;
+
+		region = region->node() ? region->node()->region() : nullptr;
+	}
+
+	return false;
+}
+
+/*
+	Returns the output that represents \p lambda in an ancestor region of \p region, or
+	nullptr if there is none. Inside of phi nodes, the recursion variable is used such
+	that no cycles are introduced.
+*/
+static jive::output *
+find_function(const lambda_node * lambda, const jive::region * region)
+{
+	jive::output * output = lambda->output(0);
+	while (true) {
+		auto phi = output->region()->node();
+		auto inside = is_ancestor(output->region(), region);
+		if (!is_phi(phi))
+			return inside ? output : nullptr;
+
+		jive::result * result = nullptr;
+		for (size_t n = 0; n < output->region()->nresults(); n++) {
+			if (output->region()->result(n)->origin() == output)
+				result = output->region()->result(n);
+		}
+		if (!result)
+			return nullptr;
+
+		if (inside)
+			return output->region()->argument(result->index());
+
+		output = result->output();
+	}
+}
+
+static bool
+is_routable(const jive::output * output, const jive::region * region)
+{
+	while (region != output->region()) {
+		auto node = region->node();
+		if (!jive::is<jive::gamma_op>(node)
+		&& !jive::is<jive::theta_op>(node)
+		&& !dynamic_cast<const lambda_node*>(node))
+			return false;
+
+		region = node->region();
+	}
+
+	return true;
+}
+
+/*
+	Replaces \p call with a gamma that compares the callee against all but the last
+	function of \p functions and invokes the matching function directly.
+*/
+static void
+dispatch(jive::simple_node * call, const std::vector<jive::output*> & functions)
+{
+	auto region = call->region();
+	auto callee = call->input(0)->origin();
+	auto & op = *static_cast<const call_op*>(&call->operation());
+	auto & pt = *static_cast<const ptrtype*>(&callee->type());
+
+	auto index = jive::create_bitconstant(region, 32, functions.size()-1);
+	for (size_t n = functions.size()-1; n > 0; n--) {
+		ptrcmp_op cop(pt, cmp::eq);
+		auto cmp = jive::simple_node::create_normalized(region, cop, {callee, functions[n-1]})[0];
+		auto c = jive::create_bitconstant(region, 32, n-1);
+
+		select_op sop(c->type());
+		index = jive::simple_node::create_normalized(region, sop, {cmp, c, index})[0];
+	}
+
+	std::unordered_map<uint64_t, uint64_t> mapping;
+	for (size_t n = 0; n < functions.size()-1; n++)
+		mapping[n] = n;
+	auto predicate = jive::match(32, mapping, functions.size()-1, functions.size(), index);
+	auto gamma = jive::gamma_node::create(predicate, functions.size());
+
+	std::vector<jive::gamma_input*> fevs;
+	for (const auto & function : functions)
+		fevs.push_back(gamma->add_entryvar(function));
+
+	std::vector<jive::gamma_input*> aevs;
+	for (size_t n = 1; n < call->ninputs(); n++)
+		aevs.push_back(gamma->add_entryvar(call->input(n)->origin()));
+
+	std::vector<std::vector<jive::output*>> results(call->noutputs());
+	for (size_t r = 0; r < gamma->nsubregions(); r++) {
+		std::vector<jive::output*> operands({fevs[r]->argument(r)});
+		for (const auto & ev : aevs)
+			operands.push_back(ev->argument(r));
+
+		auto outputs = jive::simple_node::create_normalized(gamma->subregion(r), op, operands);
+		for (size_t n = 0; n < outputs.size(); n++)
+			results[n].push_back(outputs[n]);
+	}
+
+	for (size_t n = 0; n < call->noutputs(); n++)
+		call->output(n)->divert_users(gamma->add_exitvar(results[n]));
+	remove(call);
+}
+
+static void
+devirtualize(jive::simple_node * call)
+{
+	auto callee = call->input(0)->origin();
+	if (is_direct(callee))
+		return;
+
+	targets ts;
+	if (!collect(callee, ts) || ts.lambdas().empty() || ts.lambdas().size() > max_targets)
+		return;
+
+	auto & op = *static_cast<const call_op*>(&call->operation());
+	std::vector<jive::output*> functions;
+	for (const auto & lambda : ts.lambdas()) {
+		if (lambda->fcttype() != op.fcttype())
+			return;
+
+		auto function = find_function(lambda, call->region());
+		if (!function || !is_routable(function, call->region()))
+			return;
+
+		functions.push_back(function);
+	}
+
+	for (auto & function : functions)
+		function = route_to_region(function, call->region());
+
+	if (functions.size() == 1) {
+		call->input(0)->divert_to(functions[0]);
+		return;
+	}
+
+	dispatch(call, functions);
+}
+
+static void
+collect_calls(jive::region * region, std::vector<jive::simple_node*> & calls)
+{
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				collect_calls(structnode->subregion(n), calls);
+			continue;
+		}
+
+		if (is<call_op>(&node))
+			calls.push_back(static_cast<jive::simple_node*>(&node));
+	}
+}
+
+void
+devirtualize(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef DVTTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	std::vector<jive::simple_node*> calls;
+	collect_calls(root, calls);
+
+	for (const auto & call : calls)
+		devirtualize(call);
+
+	#ifdef DVTTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "DVTTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
@@ -0,0 +1,276 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/opt/dse.hpp>
+#include <jlm/opt/pointsto.hpp>
+
+#include <jive/arch/addresstype.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/statemux.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+
+#ifdef DSETIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+class dsectx final {
+public:
+	inline
+	dsectx(
+		const pointsto & pt,
+		const jive::output * address,
+		bool local)
+	: local_(local)
+	, pt_(pt)
+	, address_(address)
+	{}
+
+	inline bool
+	local() const noexcept
+	{
+		return local_;
+	}
+
+	inline const pointsto &
+	pt() const noexcept
+	{
+		return pt_;
+	}
+
+	inline const jive::output *
+	address() const noexcept
+	{
+		return address_;
+	}
+
+	std::unordered_map<const jive::output*, bool> memo;
+
+private:
+	bool local_;
+	const pointsto & pt_;
+	const jive::output * address_;
+};
+
+/*
+	Follows addresses that are routed into gamma and theta nodes back to their origin.
+*/
+static const jive::output *
+trace(const jive::output * address)
+{
+	auto argument = dynamic_cast<const jive::argument*>(address);
+	if (!argument || !argument->input())
+		return address;
+
+	auto node = argument->region()->node();
+	if (jive::is<jive::gamma_op>(node))
+		return trace(argument->input()->origin());
+
+	auto theta = dynamic_cast<const jive::theta_node*>(node);
+	if (theta && jive::is_invariant(theta->output(argument->index())))
+		return trace(argument->input()->origin());
+
+	return address;
+}
+
+static bool
+is_local_alloca(const jive::output * address)
+{
+	if (!is<alloca_op>(address->node()))
+		return false;
+
+	std::vector<const jive::output*> worklist({address});
+	while (!worklist.empty()) {
+		auto output = worklist.back();
+		worklist.pop_back();
+
+		for (const auto & user : *output) {
+			auto node = user->node();
+			if ((is<load_op>(node) || is<store_op>(node)) && user->index() == 0)
+				continue;
+
+			if (jive::is<jive::gamma_op>(node) && user->index() != 0) {
+				for (const auto & argument : static_cast<jive::structural_input*>(user)->arguments)
+					worklist.push_back(&argument);
+				continue;
+			}
+
+			if (auto theta = dynamic_cast<jive::theta_node*>(node)) {
+				auto lv = theta->input(user->index());
+				if (lv->output()->result()->origin() != lv->argument())
+					return false;
+
+				worklist.push_back(lv->argument());
+				worklist.push_back(lv->output());
+				continue;
+			}
+
+			auto result = dynamic_cast<const jive::result*>(user);
+			if (result && jive::is<jive::theta_op>(result->region()->node()) && result->index() > 0
+			&& result->origin() == result->region()->argument(result->index()-1))
+				continue;
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool
+is_dead(const jive::output * state, dsectx & ctx);
+
+static bool
+is_dead(const jive::input * input, dsectx & ctx)
+{
+	if (auto result = dynamic_cast<const jive::result*>(input)) {
+		auto node = result->region()->node();
+
+		if (auto theta = dynamic_cast<const jive::theta_node*>(node)) {
+			if (result == theta->predicate())
+				return false;
+
+			/* next iteration and loop exit */
+			auto lv = theta->output(result->output()->index());
+			return is_dead(lv->argument(), ctx) && is_dead(lv, ctx);
+		}
+
+		if (jive::is<jive::gamma_op>(node))
+			return is_dead(result->output(), ctx);
+
+		/* the memory becomes visible outside of the function */
+		return ctx.local();
+	}
+
+	auto node = input->node();
+	if (auto gamma = dynamic_cast<const jive::gamma_node*>(node)) {
+		if (input == gamma->predicate())
+			return false;
+
+		for (const auto & argument : static_cast<const jive::structural_input*>(input)->arguments) {
+			if (!is_dead(&argument, ctx))
+				return false;
+		}
+
+		return true;
+	}
+
+	if (auto theta = dynamic_cast<const jive::theta_node*>(node))
+		return is_dead(theta->input(input->index())->argument(), ctx);
+
+	if (is<store_op>(node)) {
+		auto op = static_cast<const store_op*>(&node->operation());
+		if (op->nstates() == 1 && trace(node->input(0)->origin()) == ctx.address())
+			return true;
+
+		return is_dead(node->output(input->index()-2), ctx);
+	}
+
+	if (is<load_op>(node)) {
+		if (ctx.pt().may_alias(node->input(0)->origin(), ctx.address()))
+			return false;
+
+		return is_dead(node->output(input->index()), ctx);
+	}
+
+	if (is<jive::mux_op>(node) || is<alloca_op>(node)) {
+		for (size_t n = 0; n < node->noutputs(); n++) {
+			auto output = node->output(n);
+			if (dynamic_cast<const jive::statetype*>(&output->type()) && !is_dead(output, ctx))
+				return false;
+		}
+
+		return true;
+	}
+
+	/* calls and all other operations might read the memory */
+	return false;
+}
+
+static bool
+is_dead(const jive::output * state, dsectx & ctx)
+{
+	auto it = ctx.memo.find(state);
+	if (it != ctx.memo.end())
+		return it->second;
+
+	/*
+		Assume the state is dead while it is processed. This handles the back edge of theta
+		nodes: a loop that does not read the memory in its body does not read it at all.
+	*/
+	ctx.memo[state] = true;
+
+	bool dead = true;
+	for (const auto & user : *state) {
+		if (!is_dead(user, ctx)) {
+			dead = false;
+			break;
+		}
+	}
+
+	ctx.memo[state] = dead;
+	return dead;
+}
+
+static void
+collect_stores(jive::region * region, std::vector<jive::node*> & stores)
+{
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				collect_stores(structnode->subregion(n), stores);
+			continue;
+		}
+
+		auto op = dynamic_cast<const store_op*>(&node.operation());
+		if (op && op->nstates() == 1)
+			stores.push_back(&node);
+	}
+}
+
+static void
+dse(jive::region * region, const pointsto & pt)
+{
+	std::vector<jive::node*> stores;
+	collect_stores(region, stores);
+
+	for (const auto & store : stores) {
+		auto address = trace(store->input(0)->origin());
+		dsectx ctx(pt, address, is_local_alloca(address));
+		if (is_dead(store->output(0), ctx)) {
+			store->output(0)->divert_users(store->input(2)->origin());
+			remove(store);
+		}
+	}
+}
+
+void
+dse(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef DSETIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	auto pt = pointsto::analyze(rvsdg);
+	dse(root, *pt);
+
+	#ifdef DSETIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "DSETIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators/load.hpp>
+#include <jlm/opt/fanout.hpp>
+
+#include <jive/rvsdg/statemux.h>
+#include <jive/rvsdg/structural-node.h>
+#include <jive/rvsdg/traverser.h>
+
+#ifdef LSFTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+static inline bool
+is_single_state_load(const jive::node * node)
+{
+	auto op = dynamic_cast<const load_op*>(&node->operation());
+	return op && op->nstates() == 1;
+}
+
+static std::pair<jive::input*, jive::output*>
+memstate(const jive::node * node, const reader_fct & reader)
+{
+	if (is_single_state_load(node))
+		return {node->input(1), node->output(1)};
+
+	return reader(node);
+}
+
+static inline bool
+is_reader(const jive::node * node, const reader_fct & reader)
+{
+	return memstate(node, reader).first != nullptr;
+}
+
+/*
+	Returns the reader that consumes \p state if it is the only user of the state.
+*/
+static jive::node *
+next_reader(const jive::output * state, const reader_fct & reader)
+{
+	if (state->nusers() != 1)
+		return nullptr;
+
+	auto node = (*state->begin())->node();
+	if (!node || memstate(node, reader).first != *state->begin())
+		return nullptr;
+
+	return node;
+}
+
+/*
+	v1 s1 = load_op a1 s
+	v2 s2 = load_op a2 s1
+	...
+	vn sn = load_op an sn-1
+	=>
+	v1 s1 = load_op a1 s
+	v2 s2 = load_op a2 s
+	...
+	vn sn = load_op an s
+	sx = mux_op s1 ... sn
+*/
+static void
+fanout(jive::node * head, const reader_fct & reader)
+{
+	auto state = memstate(head, reader).first->origin();
+
+	std::vector<jive::node*> chain({head});
+	while (auto next = next_reader(memstate(chain.back(), reader).second, reader))
+		chain.push_back(next);
+
+	if (chain.size() < 2)
+		return;
+
+	auto last = memstate(chain.back(), reader).second;
+	std::vector<jive::input*> users(last->begin(), last->end());
+
+	std::vector<jive::output*> states;
+	for (const auto & node : chain) {
+		auto ms = memstate(node, reader);
+		ms.first->divert_to(state);
+		states.push_back(ms.second);
+	}
+
+	auto mux = jive::create_state_mux(last->type(), states, 1)[0];
+	for (const auto & user : users)
+		user->divert_to(mux);
+}
+
+void
+fanout_readers(jive::region * region, const reader_fct & reader)
+{
+	std::vector<jive::node*> heads;
+	for (auto & node : region->nodes) {
+		if (!is_reader(&node, reader))
+			continue;
+
+		/* only the first reader of a chain */
+		auto origin = memstate(&node, reader).first->origin();
+		if (!origin->node() || !is_reader(origin->node(), reader)
+		|| next_reader(origin, reader) != &node)
+			heads.push_back(&node);
+	}
+
+	for (const auto & head : heads)
+		fanout(head, reader);
+}
+
+static void
+fanout_loads(jive::region * region)
+{
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				fanout_loads(structnode->subregion(n));
+		}
+	}
+
+	fanout_readers(region, [](const jive::node*)
+	{
+		return std::pair<jive::input*, jive::output*>(nullptr, nullptr);
+	});
+}
+
+void
+fanout_loads(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef LSFTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	fanout_loads(root);
+
+	#ifdef LSFTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "LSFTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
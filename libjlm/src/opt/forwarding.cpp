@@ -0,0 +1,259 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators/load.hpp>
+#include <jlm/ir/operators/store.hpp>
+#include <jlm/opt/forwarding.hpp>
+#include <jlm/opt/pointsto.hpp>
+
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+
+#ifdef SLFTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+class slfctx final {
+public:
+	inline
+	slfctx(
+		const pointsto & pt,
+		const jive::output * address,
+		const jive::type & type)
+	: pt_(pt)
+	, type_(type)
+	, address_(address)
+	{}
+
+	inline const pointsto &
+	pt() const noexcept
+	{
+		return pt_;
+	}
+
+	inline const jive::type &
+	type() const noexcept
+	{
+		return type_;
+	}
+
+	inline const jive::output *
+	address() const noexcept
+	{
+		return address_;
+	}
+
+	std::unordered_map<const jive::output*, bool> reaches;
+	std::unordered_map<const jive::output*, jive::output*> values;
+
+private:
+	const pointsto & pt_;
+	const jive::type & type_;
+	const jive::output * address_;
+};
+
+/*
+	Follows addresses that are routed into gamma and theta nodes back to their origin.
+*/
+static const jive::output *
+trace(const jive::output * address)
+{
+	auto argument = dynamic_cast<const jive::argument*>(address);
+	if (!argument || !argument->input())
+		return address;
+
+	auto node = argument->region()->node();
+	if (jive::is<jive::gamma_op>(node))
+		return trace(argument->input()->origin());
+
+	auto theta = dynamic_cast<const jive::theta_node*>(node);
+	if (theta && jive::is_invariant(theta->output(argument->index())))
+		return trace(argument->input()->origin());
+
+	return address;
+}
+
+static inline bool
+is_forwardable_store(const jive::node * node, const slfctx & ctx)
+{
+	return node->input(1)->type() == ctx.type() && trace(node->input(0)->origin()) == ctx.address();
+}
+
+/*
+	Checks whether a value stored to the address reaches \p state on all paths.
+*/
+static bool
+reaches(const jive::output * state, slfctx & ctx)
+{
+	auto it = ctx.reaches.find(state);
+	if (it != ctx.reaches.end())
+		return it->second;
+
+	/*
+		Assume the value reaches the state while it is processed. This handles the back
+		edge of theta nodes: the value stored in the previous iteration or before the loop.
+	*/
+	ctx.reaches[state] = true;
+
+	bool r = false;
+	if (auto argument = dynamic_cast<const jive::argument*>(state)) {
+		auto node = argument->region()->node();
+		if (argument->input() && jive::is<jive::gamma_op>(node)) {
+			r = reaches(argument->input()->origin(), ctx);
+		} else if (argument->input() && jive::is<jive::theta_op>(node)) {
+			auto lv = static_cast<const jive::theta_node*>(node)->input(argument->input()->index());
+			r = reaches(lv->origin(), ctx) && reaches(lv->output()->result()->origin(), ctx);
+		}
+	} else if (auto gamma = dynamic_cast<const jive::gamma_node*>(state->node())) {
+		r = true;
+		for (size_t n = 0; n < gamma->nsubregions(); n++)
+			r = r && reaches(gamma->subregion(n)->result(state->index())->origin(), ctx);
+	} else if (auto theta = dynamic_cast<const jive::theta_node*>(state->node())) {
+		r = reaches(theta->output(state->index())->argument(), ctx);
+	} else if (is<store_op>(state->node())) {
+		auto node = state->node();
+		auto op = static_cast<const store_op*>(&node->operation());
+		if (op->nstates() == 1 && is_forwardable_store(node, ctx))
+			r = true;
+		else if (op->nstates() == 1 && !ctx.pt().may_alias(node->input(0)->origin(), ctx.address()))
+			r = reaches(node->input(2)->origin(), ctx);
+	} else if (is<load_op>(state->node())) {
+		auto node = state->node();
+		if (static_cast<const load_op*>(&node->operation())->nstates() == 1)
+			r = reaches(node->input(1)->origin(), ctx);
+	}
+
+	ctx.reaches[state] = r;
+	return r;
+}
+
+static jive::output *
+entryvar(jive::gamma_node * gamma, jive::output * origin, size_t alternative)
+{
+	for (size_t n = 1; n < gamma->ninputs(); n++) {
+		auto input = static_cast<jive::gamma_input*>(gamma->input(n));
+		if (input->origin() == origin)
+			return input->argument(alternative);
+	}
+
+	return gamma->add_entryvar(origin)->argument(alternative);
+}
+
+/*
+	Returns the stored value at \p state and routes it through the structural nodes
+	along the way. Requires that reaches() returned true for the state.
+*/
+static jive::output *
+route(jive::output * state, slfctx & ctx)
+{
+	auto it = ctx.values.find(state);
+	if (it != ctx.values.end())
+		return it->second;
+
+	jive::output * value = nullptr;
+	if (auto argument = dynamic_cast<jive::argument*>(state)) {
+		auto node = argument->region()->node();
+		if (auto gamma = dynamic_cast<jive::gamma_node*>(node)) {
+			auto origin = route(argument->input()->origin(), ctx);
+			value = entryvar(gamma, origin, argument->region()->index());
+		} else {
+			auto theta = static_cast<jive::theta_node*>(node);
+			auto lv = theta->input(argument->input()->index());
+
+			auto vlv = theta->add_loopvar(route(lv->origin(), ctx));
+			ctx.values[argument] = vlv->argument();
+			ctx.values[lv->output()] = vlv;
+			vlv->result()->divert_to(route(lv->output()->result()->origin(), ctx));
+			value = vlv->argument();
+		}
+	} else if (auto gamma = dynamic_cast<jive::gamma_node*>(state->node())) {
+		std::vector<jive::output*> values;
+		for (size_t n = 0; n < gamma->nsubregions(); n++)
+			values.push_back(route(gamma->subregion(n)->result(state->index())->origin(), ctx));
+		value = gamma->add_exitvar(values);
+	} else if (auto theta = dynamic_cast<jive::theta_node*>(state->node())) {
+		route(theta->output(state->index())->argument(), ctx);
+		JLM_DEBUG_ASSERT(ctx.values.find(state) != ctx.values.end());
+		return ctx.values[state];
+	} else if (is<store_op>(state->node())) {
+		auto node = state->node();
+		if (is_forwardable_store(node, ctx))
+			value = node->input(1)->origin();
+		else
+			value = route(node->input(2)->origin(), ctx);
+	} else {
+		JLM_DEBUG_ASSERT(is<load_op>(state->node()));
+		value = route(state->node()->input(1)->origin(), ctx);
+	}
+
+	ctx.values[state] = value;
+	return value;
+}
+
+static void
+collect_loads(jive::region * region, std::vector<jive::node*> & loads)
+{
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				collect_loads(structnode->subregion(n), loads);
+			continue;
+		}
+
+		auto op = dynamic_cast<const load_op*>(&node.operation());
+		if (op && op->nstates() == 1)
+			loads.push_back(&node);
+	}
+}
+
+static void
+forward_stores(jive::region * region, const pointsto & pt)
+{
+	std::vector<jive::node*> loads;
+	collect_loads(region, loads);
+
+	for (const auto & load : loads) {
+		auto state = load->input(1)->origin();
+		slfctx ctx(pt, trace(load->input(0)->origin()), load->output(0)->type());
+		if (!reaches(state, ctx))
+			continue;
+
+		/*
+			The load is only disconnected and left to dead node elimination. Removing it
+			would invalidate the outputs that are known to the points-to analysis.
+		*/
+		load->output(0)->divert_users(route(state, ctx));
+		load->output(1)->divert_users(state);
+	}
+}
+
+void
+forward_stores(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef SLFTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	auto pt = pointsto::analyze(rvsdg);
+	forward_stores(root, *pt);
+
+	#ifdef SLFTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "SLFTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/heap2stack.hpp>
+
+#include <jive/arch/addresstype.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/bitstring/constant.h>
+
+#ifdef H2STIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+/* largest allocation in bytes that is moved to the stack */
+static const size_t max_size = 1024;
+
+/* alignment guaranteed by malloc */
+static const size_t malloc_alignment = 16;
+
+/*
+	Returns the name of the imported function that is called by \p node, or an empty
+	string if the callee cannot be determined.
+*/
+static std::string
+callee(const jive::node * node)
+{
+	if (!is<call_op>(node))
+		return "";
+
+	auto origin = node->input(0)->origin();
+	while (auto argument = dynamic_cast<const jive::argument*>(origin)) {
+		if (argument->region() == argument->region()->graph()->root()) {
+			auto import = dynamic_cast<const jive::impport*>(&argument->port());
+			return import ? import->name() : "";
+		}
+
+		if (!argument->input())
+			return "";
+
+		origin = argument->input()->origin();
+	}
+
+	return "";
+}
+
+/*
+	Returns the state output of a call that corresponds to the state input \p index.
+*/
+static inline jive::output *
+state_output(const jive::node * call, size_t index)
+{
+	JLM_DEBUG_ASSERT(index >= call->ninputs() - call->noutputs());
+	return call->output(index - (call->ninputs() - call->noutputs()));
+}
+
+static void
+remove_call(jive::node * call, size_t nvalues)
+{
+	for (size_t n = nvalues; n < call->noutputs(); n++)
+		call->output(n)->divert_users(call->input(call->ninputs() - call->noutputs() + n)->origin());
+	remove(call);
+}
+
+/*
+	Checks that the allocated pointer does not escape and collects the calls to free. A call
+	to free is only accepted if it receives the pointer unchanged, i.e., routed through gamma
+	entry variables and invariant loop variables. Otherwise, it might free a different
+	pointer that was merged with the allocated one.
+*/
+static bool
+collect_frees(const jive::output * pointer, std::unordered_set<jive::node*> & frees)
+{
+	std::unordered_set<const jive::output*> visited[2];
+	std::vector<std::pair<const jive::output*, bool>> worklist({{pointer, true}});
+	auto push = [&](const jive::output * output, bool unchanged)
+	{
+		if (visited[unchanged].insert(output).second)
+			worklist.push_back({output, unchanged});
+	};
+
+	while (!worklist.empty()) {
+		auto output = worklist.back().first;
+		auto unchanged = worklist.back().second;
+		worklist.pop_back();
+
+		for (const auto & user : *output) {
+			auto node = user->node();
+			if ((is<load_op>(node) || is<store_op>(node)) && user->index() == 0)
+				continue;
+
+			if (is<getelementptr_op>(node) && user->index() == 0) {
+				push(node->output(0), false);
+				continue;
+			}
+
+			if (is<bitcast_op>(node)) {
+				push(node->output(0), unchanged);
+				continue;
+			}
+
+			if (callee(node) == "free" && user->index() == 1) {
+				if (!unchanged)
+					return false;
+
+				frees.insert(node);
+				continue;
+			}
+
+			if (auto gamma = dynamic_cast<jive::gamma_node*>(node)) {
+				if (user == gamma->predicate())
+					return false;
+
+				for (const auto & argument : static_cast<jive::structural_input*>(user)->arguments)
+					push(&argument, unchanged);
+				continue;
+			}
+
+			if (auto theta = dynamic_cast<jive::theta_node*>(node)) {
+				auto lv = theta->output(user->index());
+				auto invariant = jive::is_invariant(lv);
+				push(lv->argument(), unchanged && invariant);
+				push(lv, unchanged && invariant);
+				continue;
+			}
+
+			/* gamma outputs merge the pointer with other values */
+			auto result = dynamic_cast<const jive::result*>(user);
+			if (result && jive::is<jive::gamma_op>(result->region()->node())) {
+				push(result->output(), false);
+				continue;
+			}
+
+			if (result && jive::is<jive::theta_op>(result->region()->node()) && result->output()) {
+				auto lv = static_cast<jive::theta_node*>(result->region()->node())->output(
+					result->output()->index());
+
+				/* invariant loop variables are already handled through their input */
+				if (!jive::is_invariant(lv)) {
+					push(lv->argument(), false);
+					push(lv, false);
+				}
+				continue;
+			}
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void
+promote(jive::node * call)
+{
+	/* only pointers to bytes with a small constant size */
+	auto size = call->input(1)->origin();
+	auto pt = dynamic_cast<const ptrtype*>(&call->output(0)->type());
+	auto bt = pt ? dynamic_cast<const jive::bittype*>(&pt->pointee_type()) : nullptr;
+	if (!bt || bt->nbits() != 8 || !jive::is<jive::bitconstant_op>(size->node()))
+		return;
+
+	auto & value = static_cast<const jive::bitconstant_op*>(&size->node()->operation())->value();
+	if (!value.is_defined() || value.to_uint() > max_size)
+		return;
+
+	/* the pointer must be freed exactly once in the same region */
+	std::unordered_set<jive::node*> frees;
+	if (!collect_frees(call->output(0), frees) || frees.size() != 1
+	|| (*frees.begin())->region() != call->region())
+		return;
+
+	size_t mstate = 0;
+	for (size_t n = 2; n < call->ninputs(); n++) {
+		if (dynamic_cast<const jive::memtype*>(&call->input(n)->type()))
+			mstate = n;
+	}
+	if (mstate == 0)
+		return;
+
+	auto alloca = create_alloca(*bt, size, call->input(mstate)->origin(), malloc_alignment);
+	call->output(0)->divert_users(alloca[0]);
+	state_output(call, mstate)->divert_users(alloca[1]);
+	remove_call(call, 1);
+	remove_call(*frees.begin(), 0);
+}
+
+static void
+heap2stack(jive::region * region)
+{
+	std::vector<jive::node*> mallocs;
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				heap2stack(structnode->subregion(n));
+			continue;
+		}
+
+		/*
+			Allocas are only introduced at the top level of a function, otherwise allocations
+			in loops would grow the stack with every iteration.
+		*/
+		if (is<lambda_op>(region->node()) && callee(&node) == "malloc" && node.ninputs() > 2)
+			mallocs.push_back(&node);
+	}
+
+	for (const auto & call : mallocs)
+		promote(call);
+}
+
+void
+heap2stack(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef H2STIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	heap2stack(root);
+
+	#ifdef H2STIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "H2STIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
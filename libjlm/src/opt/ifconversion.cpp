@@ -0,0 +1,263 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/opt/ifconversion.hpp>
+#include <jlm/opt/pull.hpp>
+
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/substitution.h>
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/constant.h>
+
+#ifdef IFCTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+/* maximum number of speculated operations */
+static const size_t max_cost = 4;
+
+static inline bool
+is_constant(const jive::node * node)
+{
+	return jive::is<jive::bitconstant_op>(node)
+	    || jive::is<jive::ctlconstant_op>(node)
+	    || is<fpconstant_op>(node)
+	    || is<undef_constant_op>(node);
+}
+
+static inline size_t
+cost(const jive::node * node)
+{
+	return is_constant(node) ? 0 : 1;
+}
+
+/*
+	Returns true if \p node can be executed speculatively, i.e., it neither touches state
+	nor traps.
+*/
+static bool
+is_speculatable(const jive::node * node)
+{
+	if (!dynamic_cast<const jive::simple_op*>(&node->operation()))
+		return false;
+
+	if (jive::is<jive::bitsdiv_op>(node) || jive::is<jive::bitudiv_op>(node)
+	|| jive::is<jive::bitsmod_op>(node) || jive::is<jive::bitumod_op>(node))
+		return false;
+
+	for (size_t n = 0; n < node->ninputs(); n++) {
+		if (!dynamic_cast<const jive::valuetype*>(&node->input(n)->type()))
+			return false;
+	}
+
+	for (size_t n = 0; n < node->noutputs(); n++) {
+		if (!dynamic_cast<const jive::valuetype*>(&node->output(n)->type()))
+			return false;
+	}
+
+	return true;
+}
+
+static bool
+is_convertible(const jive::gamma_node * gamma)
+{
+	if (gamma->nsubregions() != 2)
+		return false;
+
+	/* empty gammas are already translated to selects */
+	if (gamma->subregion(0)->nnodes() == 0 && gamma->subregion(1)->nnodes() == 0)
+		return false;
+
+	size_t c = 0;
+	for (size_t r = 0; r < gamma->nsubregions(); r++) {
+		for (const auto & node : gamma->subregion(r)->nodes) {
+			if (!is_speculatable(&node))
+				return false;
+			c += cost(&node);
+		}
+	}
+
+	if (c > max_cost)
+		return false;
+
+	/* states cannot be selected, they must be passed through unchanged */
+	for (size_t n = 0; n < gamma->noutputs(); n++) {
+		auto o0 = gamma->subregion(0)->result(n)->origin();
+		auto o1 = gamma->subregion(1)->result(n)->origin();
+		if (dynamic_cast<const jive::valuetype*>(&gamma->output(n)->type()))
+			continue;
+
+		auto a0 = dynamic_cast<const jive::argument*>(o0);
+		auto a1 = dynamic_cast<const jive::argument*>(o1);
+		if (!a0 || !a1 || a0->input() != a1->input())
+			return false;
+	}
+
+	return true;
+}
+
+/*
+	Creates the select operation that yields \p o1 if the gamma predicate selects the
+	second alternative, and \p o0 otherwise.
+*/
+static jive::output *
+create_select(jive::output * predicate, jive::output * o0, jive::output * o1)
+{
+	auto region = predicate->region();
+
+	jive::output * p;
+	bool swap = false;
+	auto node = predicate->node();
+	auto match = node ? dynamic_cast<const jive::match_op*>(&node->operation()) : nullptr;
+	if (match && match->nbits() == 1) {
+		p = node->input(0)->origin();
+		swap = match->alternative(1) != 1;
+	} else {
+		ctl2bits_op op(jive::ctltype(2), jive::bit1);
+		p = jive::simple_node::create_normalized(region, op, {predicate})[0];
+	}
+
+	select_op op(o0->type());
+	auto t = swap ? o0 : o1;
+	auto f = swap ? o1 : o0;
+	return jive::simple_node::create_normalized(region, op, {p, t, f})[0];
+}
+
+static void
+convert_gamma(jive::gamma_node * gamma)
+{
+	auto predicate = gamma->predicate()->origin();
+
+	std::vector<jive::substitution_map> smaps(gamma->nsubregions());
+	for (size_t r = 0; r < gamma->nsubregions(); r++) {
+		for (auto ev = gamma->begin_entryvar(); ev != gamma->end_entryvar(); ev++)
+			smaps[r].insert(ev->argument(r), ev->origin());
+
+		gamma->subregion(r)->copy(gamma->region(), smaps[r], false, false);
+	}
+
+	for (size_t n = 0; n < gamma->noutputs(); n++) {
+		auto o0 = smaps[0].lookup(gamma->subregion(0)->result(n)->origin());
+		auto o1 = smaps[1].lookup(gamma->subregion(1)->result(n)->origin());
+		auto output = o0 == o1 ? o0 : create_select(predicate, o0, o1);
+		gamma->output(n)->divert_users(output);
+	}
+	remove(gamma);
+}
+
+/*
+	Returns the cost of the computations that are only used by operand \p index of the
+	select \p node.
+*/
+static size_t
+exclusive_cost(const jive::node * node, size_t index)
+{
+	std::unordered_set<const jive::node*> cone({node});
+	std::vector<const jive::node*> worklist;
+
+	auto push = [&](const jive::output * output)
+	{
+		auto producer = output->node();
+		if (!producer || cone.find(producer) != cone.end() || !is_speculatable(producer))
+			return;
+
+		for (size_t n = 0; n < producer->noutputs(); n++) {
+			for (const auto & user : *producer->output(n)) {
+				if (user->node() == node && user->index() != index)
+					return;
+				if (cone.find(user->node()) == cone.end())
+					return;
+			}
+		}
+
+		cone.insert(producer);
+		worklist.push_back(producer);
+	};
+
+	size_t c = 0;
+	push(node->input(index)->origin());
+	while (!worklist.empty()) {
+		auto producer = worklist.back();
+		worklist.pop_back();
+
+		c += cost(producer);
+		for (size_t n = 0; n < producer->ninputs(); n++)
+			push(producer->input(n)->origin());
+	}
+
+	return c;
+}
+
+static void
+convert_select(jive::node * select)
+{
+	auto p = select->input(0)->origin();
+
+	auto predicate = jive::match(1, {{1, 1}}, 0, 2, p);
+	auto gamma = jive::gamma_node::create(predicate, 2);
+	auto ev0 = gamma->add_entryvar(select->input(2)->origin());
+	auto ev1 = gamma->add_entryvar(select->input(1)->origin());
+	select->output(0)->divert_users(gamma->add_exitvar({ev0->argument(0), ev1->argument(1)}));
+	remove(select);
+
+	/* sink the operands into the alternatives and remove the copies that are not used */
+	pullin_top(gamma);
+	for (size_t r = 0; r < gamma->nsubregions(); r++)
+		gamma->subregion(r)->prune(false);
+}
+
+static void
+ifconvert(jive::region * region)
+{
+	std::vector<jive::node*> nodes;
+	for (const auto & node : jive::topdown_traverser(region))
+		nodes.push_back(node);
+
+	for (const auto & node : nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				ifconvert(structnode->subregion(n));
+
+			auto gamma = dynamic_cast<jive::gamma_node*>(node);
+			if (gamma && is_convertible(gamma))
+				convert_gamma(gamma);
+			continue;
+		}
+
+		if (is<select_op>(node)
+		&& std::max(exclusive_cost(node, 1), exclusive_cost(node, 2)) > max_cost)
+			convert_select(node);
+	}
+}
+
+void
+ifconvert(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef IFCTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	ifconvert(root);
+
+	#ifdef IFCTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "IFCTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
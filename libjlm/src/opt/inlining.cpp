@@ -80,7 +80,7 @@ find_producer(jive::input * input)
 	return find_producer(argument->input());
 }
 
-static jive::output *
+jive::output *
 route_to_region(jive::output * output, jive::region * region)
 {
 	JLM_DEBUG_ASSERT(region != nullptr);
@@ -0,0 +1,296 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/opt/inlining.hpp>
+#include <jlm/opt/ipcp.hpp>
+
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/substitution.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/bitstring/constant.h>
+
+#ifdef IPCPTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+/* largest lambda in number of nodes that is specialized */
+static const size_t max_size = 100;
+
+/* total number of nodes that specialization is allowed to add */
+static const size_t max_growth = 1000;
+
+/* number of calls with the same constant arguments before a lambda is specialized */
+static const size_t min_calls = 2;
+
+typedef std::vector<const jive::bitconstant_op*> signature;
+
+/*
+	Collects the calls of a lambda. Returns false if the lambda escapes, i.e., is used
+	by anything other than the function operand of a call.
+*/
+static bool
+collect_calls(const lambda_node * lambda, std::vector<jive::node*> & calls)
+{
+	std::unordered_set<jive::output*> worklist({lambda->output(0)});
+	while (!worklist.empty()) {
+		auto output = *worklist.begin();
+		worklist.erase(output);
+
+		for (const auto & user : *output) {
+			if (auto result = dynamic_cast<const jive::result*>(user)) {
+				if (result->output() == nullptr)
+					return false;
+
+				worklist.insert(result->output());
+				continue;
+			}
+
+			if (is<call_op>(user->node()) && user->index() == 0) {
+				calls.push_back(user->node());
+				continue;
+			}
+
+			auto sinput = dynamic_cast<jive::structural_input*>(user);
+			if (sinput == nullptr)
+				return false;
+
+			for (auto & argument : sinput->arguments)
+				worklist.insert(&argument);
+		}
+	}
+
+	return true;
+}
+
+/*
+	Returns the constant that reaches \p output, or nullptr if there is none.
+*/
+static const jive::bitconstant_op *
+constant(const jive::output * output)
+{
+	while (auto argument = dynamic_cast<const jive::argument*>(output)) {
+		if (!argument->input())
+			return nullptr;
+
+		auto theta = dynamic_cast<const jive::theta_node*>(argument->region()->node());
+		if (theta && !jive::is_invariant(theta->output(argument->index())))
+			return nullptr;
+
+		output = argument->input()->origin();
+	}
+
+	if (!jive::is<jive::bitconstant_op>(output->node()))
+		return nullptr;
+
+	return static_cast<const jive::bitconstant_op*>(&output->node()->operation());
+}
+
+static signature
+compute_signature(const jive::node * call)
+{
+	signature s;
+	for (size_t n = 1; n < call->ninputs(); n++)
+		s.push_back(constant(call->input(n)->origin()));
+
+	return s;
+}
+
+static inline bool
+equal(const jive::bitconstant_op * c1, const jive::bitconstant_op * c2)
+{
+	if (c1 == nullptr || c2 == nullptr)
+		return c1 == c2;
+
+	return *c1 == *c2;
+}
+
+static bool
+equal(const signature & s1, const signature & s2)
+{
+	JLM_DEBUG_ASSERT(s1.size() == s2.size());
+
+	for (size_t n = 0; n < s1.size(); n++) {
+		if (!equal(s1[n], s2[n]))
+			return false;
+	}
+
+	return true;
+}
+
+static bool
+has_constants(const signature & s)
+{
+	for (const auto & c : s) {
+		if (c != nullptr)
+			return true;
+	}
+
+	return false;
+}
+
+/*
+	Replaces all arguments of \p lambda that receive the same constant from every call.
+*/
+static void
+substitute_arguments(lambda_node * lambda, const std::vector<signature> & signatures)
+{
+	auto arguments = lambda->arguments();
+	for (size_t n = 0; n < arguments.size(); n++) {
+		auto c = signatures[0][n];
+		for (const auto & s : signatures) {
+			if (!c || !equal(s[n], c)) {
+				c = nullptr;
+				break;
+			}
+		}
+
+		if (c == nullptr || arguments[n]->nusers() == 0)
+			continue;
+
+		auto value = jive::simple_node::create_normalized(lambda->subregion(), *c, {})[0];
+		arguments[n]->divert_users(value);
+	}
+}
+
+static bool
+is_routable(const jive::region * region)
+{
+	while (region != region->graph()->root()) {
+		auto node = region->node();
+		if (!jive::is<jive::gamma_op>(node) && !jive::is<jive::theta_op>(node)
+		&& !is<lambda_op>(node))
+			return false;
+
+		region = node->region();
+	}
+
+	return true;
+}
+
+/*
+	Creates a copy of \p lambda with the constant arguments of \p s substituted.
+*/
+static lambda_node *
+specialize(const lambda_node * lambda, const signature & s, size_t id)
+{
+	auto name = lambda->name() + ".spec" + std::to_string(id);
+	lambda_op op(lambda->fcttype(), name, linkage::internal_linkage);
+
+	jlm::lambda_builder lb;
+	auto arguments = lb.begin_lambda(lambda->region(), op);
+
+	jive::substitution_map smap;
+	auto oldargs = lambda->arguments();
+	for (size_t n = 0; n < oldargs.size(); n++) {
+		if (s[n])
+			smap.insert(oldargs[n], jive::simple_node::create_normalized(lb.subregion(), *s[n], {})[0]);
+		else
+			smap.insert(oldargs[n], arguments[n]);
+	}
+
+	for (size_t n = 0; n < lambda->ninputs(); n++) {
+		auto input = lambda->input(n);
+		smap.insert(input->arguments.first(), lb.add_dependency(input->origin()));
+	}
+
+	lambda->subregion()->copy(lb.subregion(), smap, false, false);
+
+	std::vector<jive::output*> results;
+	for (size_t n = 0; n < lambda->subregion()->nresults(); n++)
+		results.push_back(smap.lookup(lambda->subregion()->result(n)->origin()));
+
+	return lb.end_lambda(results);
+}
+
+static void
+ipcp(lambda_node * lambda, size_t & growth, size_t & nspecializations)
+{
+	if (is_externally_visible(lambda->linkage()))
+		return;
+
+	std::vector<jive::node*> calls;
+	if (!collect_calls(lambda, calls) || calls.empty())
+		return;
+
+	std::vector<signature> signatures;
+	for (const auto & call : calls)
+		signatures.push_back(compute_signature(call));
+
+	substitute_arguments(lambda, signatures);
+
+	/* group the calls by their constant arguments */
+	std::vector<std::pair<signature, std::vector<jive::node*>>> groups;
+	for (size_t n = 0; n < calls.size(); n++) {
+		if (!has_constants(signatures[n]) || !is_routable(calls[n]->region()))
+			continue;
+
+		auto it = groups.begin();
+		for (; it != groups.end(); it++) {
+			if (equal(it->first, signatures[n]))
+				break;
+		}
+
+		if (it != groups.end())
+			it->second.push_back(calls[n]);
+		else
+			groups.push_back({signatures[n], {calls[n]}});
+	}
+
+	auto size = jive::nnodes(lambda->subregion());
+	if (size > max_size)
+		return;
+
+	for (const auto & group : groups) {
+		/* all calls agree, the arguments were already substituted */
+		if (group.second.size() == calls.size())
+			break;
+
+		if (group.second.size() < min_calls || growth + size > max_growth)
+			continue;
+
+		auto clone = specialize(lambda, group.first, nspecializations++);
+		for (const auto & call : group.second)
+			call->input(0)->divert_to(route_to_region(clone->output(0), call->region()));
+		growth += size;
+	}
+}
+
+void
+ipcp(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef IPCPTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	std::vector<lambda_node*> lambdas;
+	for (auto & node : root->nodes) {
+		if (auto lambda = dynamic_cast<lambda_node*>(&node))
+			lambdas.push_back(lambda);
+	}
+
+	size_t growth = 0;
+	size_t nspecializations = 0;
+	for (const auto & lambda : lambdas)
+		ipcp(lambda, growth, nspecializations);
+
+	#ifdef IPCPTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "IPCPTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/opt/loopdeletion.hpp>
+#include <jlm/opt/unroll.hpp>
+
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+
+#ifdef LDLTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+static bool
+terminates(jive::theta_node * theta)
+{
+	auto ui = unrollinfo::create(theta);
+	return ui && ui->niterations();
+}
+
+bool
+delete_loop(jive::theta_node * theta)
+{
+	if (!terminates(theta))
+		return false;
+
+	/*
+		Theta invariance does not redirect invariant loop states as termination is
+		unknown in general. We know the loop terminates, so all of them can be redirected.
+	*/
+	for (const auto & lv : *theta) {
+		if (jive::is_invariant(lv))
+			lv->divert_users(lv->input()->origin());
+	}
+
+	for (const auto & lv : *theta) {
+		if (lv->nusers() != 0)
+			return false;
+	}
+
+	remove(theta);
+	return true;
+}
+
+static void
+delete_loops(jive::region * region)
+{
+	for (auto & node : jive::bottomup_traverser(region)) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				delete_loops(structnode->subregion(n));
+
+			if (auto theta = dynamic_cast<jive::theta_node*>(node))
+				delete_loop(theta);
+		}
+	}
+}
+
+void
+delete_loops(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef LDLTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	delete_loops(root);
+
+	#ifdef LDLTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "LDLTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
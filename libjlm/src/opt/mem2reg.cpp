@@ -0,0 +1,317 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators/alloca.hpp>
+#include <jlm/ir/operators/load.hpp>
+#include <jlm/ir/operators/operators.hpp>
+#include <jlm/ir/operators/store.hpp>
+#include <jlm/opt/mem2reg.hpp>
+
+#include <jive/arch/addresstype.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+
+#ifdef M2RTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+static bool
+is_access(const jive::input * input)
+{
+	auto node = input->node();
+	if (!node || input->index() != 0)
+		return false;
+
+	if (auto op = dynamic_cast<const load_op*>(&node->operation()))
+		return op->nstates() == 1;
+
+	if (auto op = dynamic_cast<const store_op*>(&node->operation()))
+		return op->nstates() == 1;
+
+	return false;
+}
+
+static jive::output *
+state_output(const jive::node * node)
+{
+	JLM_DEBUG_ASSERT(is<load_op>(node) || is<store_op>(node));
+	return is<load_op>(node) ? node->output(1) : node->output(0);
+}
+
+static bool
+is_invariant_result(const jive::input * input, const jive::output * argument)
+{
+	auto result = dynamic_cast<const jive::result*>(input);
+	if (!result || !jive::is<jive::theta_op>(result->region()->node()) || result->index() == 0)
+		return false;
+
+	return result->region()->argument(result->index()-1) == argument;
+}
+
+/*
+	Collects all loads and stores from the given address. Returns false if the address
+	is used in any other way, i.e., it escapes.
+*/
+static bool
+collect_accesses(jive::output * address, std::unordered_set<jive::node*> & accesses)
+{
+	for (const auto & user : *address) {
+		if (is_access(user)) {
+			accesses.insert(user->node());
+			continue;
+		}
+
+		if (is_invariant_result(user, address))
+			continue;
+
+		if (auto gamma = dynamic_cast<jive::gamma_node*>(user->node())) {
+			if (user == gamma->predicate())
+				return false;
+
+			auto ev = static_cast<jive::gamma_input*>(user);
+			for (size_t n = 0; n < ev->narguments(); n++) {
+				if (!collect_accesses(ev->argument(n), accesses))
+					return false;
+			}
+			continue;
+		}
+
+		if (auto theta = dynamic_cast<jive::theta_node*>(user->node())) {
+			auto lv = theta->input(user->index());
+			if (lv->output()->result()->origin() != lv->argument())
+				return false;
+
+			if (!collect_accesses(lv->argument(), accesses)
+			|| !collect_accesses(lv->output(), accesses))
+				return false;
+			continue;
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+/*
+	Returns the memory state output of a simple node that corresponds to the memory
+	state input \p input.
+*/
+static jive::output *
+next_state(const jive::input * input)
+{
+	auto node = input->node();
+
+	jive::output * state = nullptr;
+	for (size_t n = 0; n < node->noutputs(); n++) {
+		if (!dynamic_cast<const jive::memtype*>(&node->output(n)->type()))
+			continue;
+
+		if (state) return nullptr;
+		state = node->output(n);
+	}
+
+	for (size_t n = 0; n < node->ninputs(); n++) {
+		auto i = node->input(n);
+		if (i != input && dynamic_cast<const jive::memtype*>(&i->type()))
+			return nullptr;
+	}
+
+	return state;
+}
+
+/*
+	Follows the memory state through a region and counts the encountered accesses.
+	Returns the result the state ends in, or nullptr if the state cannot be followed.
+*/
+static jive::result *
+check_chain(
+	jive::output * state,
+	const std::unordered_set<jive::node*> & accesses,
+	size_t & naccesses)
+{
+	while (true) {
+		if (state->nusers() != 1)
+			return nullptr;
+
+		auto user = *state->begin();
+		if (auto result = dynamic_cast<jive::result*>(user))
+			return result;
+
+		auto node = user->node();
+		if (accesses.find(node) != accesses.end()) {
+			naccesses++;
+			state = state_output(node);
+			continue;
+		}
+
+		if (auto gamma = dynamic_cast<jive::gamma_node*>(node)) {
+			auto ev = static_cast<jive::gamma_input*>(user);
+
+			jive::result * end = nullptr;
+			for (size_t n = 0; n < ev->narguments(); n++) {
+				auto result = check_chain(ev->argument(n), accesses, naccesses);
+				if (!result || (end && end->index() != result->index()))
+					return nullptr;
+				end = result;
+			}
+
+			state = gamma->output(end->index());
+			continue;
+		}
+
+		if (auto theta = dynamic_cast<jive::theta_node*>(node)) {
+			auto lv = theta->input(user->index());
+			if (check_chain(lv->argument(), accesses, naccesses) != lv->output()->result())
+				return nullptr;
+
+			state = lv->output();
+			continue;
+		}
+
+		if (!dynamic_cast<jive::simple_node*>(node) || !(state = next_state(user)))
+			return nullptr;
+	}
+}
+
+/*
+	Follows the memory state through a region and replaces the accesses with the value
+	of the alloca. Returns the value at the end of the region.
+*/
+static jive::output *
+promote_chain(
+	jive::output * state,
+	jive::output * value,
+	const std::unordered_set<jive::node*> & accesses,
+	jive::result ** end)
+{
+	while (true) {
+		JLM_DEBUG_ASSERT(state->nusers() == 1);
+		auto user = *state->begin();
+		if (auto result = dynamic_cast<jive::result*>(user)) {
+			*end = result;
+			return value;
+		}
+
+		auto node = user->node();
+		if (accesses.find(node) != accesses.end()) {
+			if (is<load_op>(node)) {
+				node->output(0)->divert_users(value);
+				node->output(1)->divert_users(state);
+			} else {
+				value = node->input(1)->origin();
+				node->output(0)->divert_users(state);
+			}
+			remove(node);
+			continue;
+		}
+
+		if (auto gamma = dynamic_cast<jive::gamma_node*>(node)) {
+			auto ev = static_cast<jive::gamma_input*>(user);
+			auto vev = gamma->add_entryvar(value);
+
+			jive::result * result = nullptr;
+			std::vector<jive::output*> values;
+			for (size_t n = 0; n < ev->narguments(); n++)
+				values.push_back(promote_chain(ev->argument(n), vev->argument(n), accesses, &result));
+
+			value = gamma->add_exitvar(values);
+			state = gamma->output(result->index());
+			continue;
+		}
+
+		if (auto theta = dynamic_cast<jive::theta_node*>(node)) {
+			auto lv = theta->input(user->index())->output();
+			auto vlv = theta->add_loopvar(value);
+
+			jive::result * result = nullptr;
+			auto v = promote_chain(lv->argument(), vlv->argument(), accesses, &result);
+			JLM_DEBUG_ASSERT(result == lv->result());
+			vlv->result()->divert_to(v);
+
+			value = vlv;
+			state = lv;
+			continue;
+		}
+
+		state = next_state(user);
+		JLM_DEBUG_ASSERT(state != nullptr);
+	}
+}
+
+static void
+promote(jive::node * alloca)
+{
+	JLM_DEBUG_ASSERT(is<alloca_op>(alloca));
+
+	std::unordered_set<jive::node*> accesses;
+	if (!collect_accesses(alloca->output(0), accesses))
+		return;
+
+	size_t naccesses = 0;
+	if (!check_chain(alloca->output(1), accesses, naccesses) || naccesses != accesses.size())
+		return;
+
+	auto op = static_cast<const alloca_op*>(&alloca->operation());
+	auto undef = undef_constant_op::create(alloca->region(), op->value_type());
+
+	jive::result * end = nullptr;
+	promote_chain(alloca->output(1), undef, accesses, &end);
+
+	/*
+		The address might still be routed into structural nodes. These dead
+		arguments and the alloca itself are removed by dead node elimination.
+	*/
+	alloca->output(1)->divert_users(alloca->input(1)->origin());
+	if (alloca->output(0)->nusers() == 0)
+		remove(alloca);
+}
+
+static void
+mem2reg(jive::region * region)
+{
+	std::vector<jive::node*> allocas;
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				mem2reg(structnode->subregion(n));
+			continue;
+		}
+
+		if (is<alloca_op>(&node))
+			allocas.push_back(&node);
+	}
+
+	for (const auto & alloca : allocas)
+		promote(alloca);
+}
+
+void
+mem2reg(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef M2RTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	mem2reg(root);
+
+	#ifdef M2RTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "M2RTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
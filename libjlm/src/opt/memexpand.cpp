@@ -0,0 +1,203 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/memexpand.hpp>
+
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/bitstring/constant.h>
+
+#ifdef MEXTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+/* largest length in bytes that is expanded */
+static const size_t max_length = 32;
+
+static bool
+is_constant(const jive::output * output, size_t & value)
+{
+	if (!jive::is<jive::bitconstant_op>(output->node()))
+		return false;
+
+	auto op = static_cast<const jive::bitconstant_op*>(&output->node()->operation());
+	if (!op->value().is_defined())
+		return false;
+
+	value = op->value().to_uint();
+	return true;
+}
+
+static inline bool
+is_byte_pointer(const jive::output * output)
+{
+	auto pt = static_cast<const ptrtype*>(&output->type());
+	auto bt = dynamic_cast<const jive::bittype*>(&pt->pointee_type());
+	return bt && bt->nbits() == 8;
+}
+
+/*
+	Splits a copy of \p length bytes into accesses of 8, 4, 2, or 1 bytes.
+*/
+static std::vector<std::pair<size_t, size_t>>
+split(size_t length, size_t maxsize)
+{
+	std::vector<std::pair<size_t, size_t>> chunks;
+	size_t offset = 0;
+	for (size_t size = maxsize; size > 0; size /= 2) {
+		for (; offset + size <= length; offset += size)
+			chunks.push_back({offset, size});
+	}
+
+	return chunks;
+}
+
+static size_t
+alignment(size_t base, size_t offset, size_t size)
+{
+	while (offset % base != 0)
+		base /= 2;
+
+	return std::min(base, size);
+}
+
+/*
+	Returns a pointer to a value of \p size bytes at \p offset from the byte pointer
+	\p address.
+*/
+static jive::output *
+address(jive::output * address, size_t offset, size_t size)
+{
+	auto region = address->region();
+	auto & pt = *static_cast<const ptrtype*>(&address->type());
+
+	if (offset != 0) {
+		auto index = jive::create_bitconstant(region, 64, offset);
+		getelementptr_op op(pt, {jive::bittype(64)}, pt);
+		address = jive::simple_node::create_normalized(region, op, {address, index})[0];
+	}
+
+	if (size != 1) {
+		bitcast_op op(pt, ptrtype(jive::bittype(8*size)));
+		address = jive::simple_node::create_normalized(region, op, {address})[0];
+	}
+
+	return address;
+}
+
+static void
+expand_memcpy(jive::node * node)
+{
+	auto op = static_cast<const memcpy_op*>(&node->operation());
+	auto destination = node->input(0)->origin();
+	auto source = node->input(1)->origin();
+
+	size_t length;
+	if (!is_constant(node->input(2)->origin(), length) || length > max_length
+	|| !is_byte_pointer(destination) || !is_byte_pointer(source))
+		return;
+
+	std::vector<jive::output*> states;
+	for (size_t n = 3; n < node->ninputs(); n++)
+		states.push_back(node->input(n)->origin());
+
+	for (const auto & chunk : split(length, 8)) {
+		auto a = alignment(op->alignment(), chunk.first, chunk.second);
+		auto ld = create_load(address(source, chunk.first, chunk.second), states, a);
+		states = create_store(address(destination, chunk.first, chunk.second), ld[0],
+			{std::next(ld.begin()), ld.end()}, a);
+	}
+
+	divert_users(node, states);
+	remove(node);
+}
+
+static void
+expand_memset(jive::node * node)
+{
+	auto op = static_cast<const memset_op*>(&node->operation());
+	auto destination = node->input(0)->origin();
+	auto value = node->input(1)->origin();
+
+	size_t length;
+	if (!is_constant(node->input(2)->origin(), length) || length > max_length
+	|| !is_byte_pointer(destination))
+		return;
+
+	/* wider stores require the value to be known */
+	size_t byte;
+	auto constant = is_constant(value, byte);
+
+	std::vector<jive::output*> states;
+	for (size_t n = 3; n < node->ninputs(); n++)
+		states.push_back(node->input(n)->origin());
+
+	for (const auto & chunk : split(length, constant ? 8 : 1)) {
+		auto v = value;
+		if (chunk.second != 1) {
+			uint64_t replicated = 0;
+			for (size_t n = 0; n < chunk.second; n++)
+				replicated = (replicated << 8) | (byte & 0xff);
+			v = jive::create_bitconstant(node->region(), 8*chunk.second, replicated);
+		}
+
+		auto a = alignment(op->alignment(), chunk.first, chunk.second);
+		states = create_store(address(destination, chunk.first, chunk.second), v, states, a);
+	}
+
+	divert_users(node, states);
+	remove(node);
+}
+
+static void
+expand_memops(jive::region * region)
+{
+	std::vector<jive::node*> nodes;
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				expand_memops(structnode->subregion(n));
+			continue;
+		}
+
+		if (is<memcpy_op>(&node) || is<memset_op>(&node))
+			nodes.push_back(&node);
+	}
+
+	for (const auto & node : nodes) {
+		if (is<memcpy_op>(node))
+			expand_memcpy(node);
+		else
+			expand_memset(node);
+	}
+}
+
+void
+expand_memops(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef MEXTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	expand_memops(root);
+
+	#ifdef MEXTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "MEXTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/fanout.hpp>
+#include <jlm/opt/modref.hpp>
+
+#include <jive/arch/addresstype.h>
+#include <jive/rvsdg/phi.h>
+#include <jive/rvsdg/statemux.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+
+#ifdef MRSTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+class summary final {
+public:
+	inline
+	summary(bool ref, bool mod, bool loops)
+	: ref(ref)
+	, mod(mod)
+	, loops(loops)
+	{}
+
+	inline void
+	merge(const summary & other) noexcept
+	{
+		ref = ref || other.ref;
+		mod = mod || other.mod;
+		loops = loops || other.loops;
+	}
+
+	bool ref;
+	bool mod;
+	bool loops;
+};
+
+typedef std::unordered_map<const jive::node*, summary> summarymap;
+
+/*
+	Returns the lambda that is called by \p call, or nullptr if it cannot be determined.
+	Calls through recursion variables are not resolved.
+*/
+static const lambda_node *
+callee(const jive::node * call)
+{
+	auto origin = call->input(0)->origin();
+	while (auto argument = dynamic_cast<const jive::argument*>(origin)) {
+		if (!argument->input())
+			return nullptr;
+
+		auto theta = dynamic_cast<const jive::theta_node*>(argument->region()->node());
+		if (theta && !jive::is_invariant(theta->output(argument->index())))
+			return nullptr;
+
+		origin = argument->input()->origin();
+	}
+
+	return dynamic_cast<const lambda_node*>(origin->node());
+}
+
+static inline bool
+is_memstate(const jive::type & type)
+{
+	return dynamic_cast<const jive::memtype*>(&type) != nullptr;
+}
+
+static inline bool
+is_loopstate(const jive::type & type)
+{
+	return dynamic_cast<const loopstatetype*>(&type) != nullptr;
+}
+
+/*
+	The states of a call are the trailing operands and results.
+*/
+static inline jive::input *
+state_input(const jive::node * call, const jive::output * output)
+{
+	return call->input(call->ninputs() - call->noutputs() + output->index());
+}
+
+static jive::output *
+state_argument(const jive::region * region, const jive::type & type)
+{
+	for (size_t n = 0; n < region->narguments(); n++) {
+		if (region->argument(n)->type() == type)
+			return region->argument(n);
+	}
+
+	return nullptr;
+}
+
+static summary
+summarize(const jive::region * region, const summarymap & summaries)
+{
+	summary s(false, false, false);
+	for (const auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<const jive::structural_node*>(&node)) {
+			if (jive::is<jive::theta_op>(&node))
+				s.loops = true;
+
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				s.merge(summarize(structnode->subregion(n), summaries));
+			continue;
+		}
+
+		if (is<load_op>(&node)) {
+			s.ref = true;
+		} else if (is<store_op>(&node)) {
+			s.mod = true;
+		} else if (is<call_op>(&node)) {
+			auto lambda = callee(&node);
+			auto it = lambda ? summaries.find(lambda) : summaries.end();
+			s.merge(it != summaries.end() ? it->second : summary(true, true, true));
+		} else if (!is<alloca_op>(&node) && !is<jive::mux_op>(&node)) {
+			/* any other operation on memory might read or write it */
+			for (size_t n = 0; n < node.ninputs(); n++) {
+				if (is_memstate(node.input(n)->type()))
+					s.merge(summary(true, true, false));
+			}
+		}
+	}
+
+	return s;
+}
+
+/*
+	Returns the memory state input and output of a call to a read-only function.
+*/
+static std::pair<jive::input*, jive::output*>
+memstate(const jive::node * node, const std::unordered_set<const jive::node*> & readers)
+{
+	if (readers.find(node) == readers.end())
+		return {nullptr, nullptr};
+
+	for (size_t n = 0; n < node->noutputs(); n++) {
+		if (is_memstate(node->output(n)->type()))
+			return {state_input(node, node->output(n)), node->output(n)};
+	}
+
+	return {nullptr, nullptr};
+}
+
+static void
+rewire_calls(jive::region * region, const summarymap & summaries)
+{
+	std::unordered_set<const jive::node*> readers;
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				rewire_calls(structnode->subregion(n), summaries);
+			continue;
+		}
+
+		auto lambda = is<call_op>(&node) ? callee(&node) : nullptr;
+		auto it = lambda ? summaries.find(lambda) : summaries.end();
+		if (it == summaries.end())
+			continue;
+
+		auto & s = it->second;
+		for (size_t n = 0; n < node.noutputs(); n++) {
+			auto output = node.output(n);
+			if ((is_loopstate(output->type()) && !s.loops)
+			|| (is_memstate(output->type()) && !s.ref && !s.mod)) {
+				auto input = state_input(&node, output);
+				output->divert_users(input->origin());
+
+				/* the state is ignored, so give equal calls a common state */
+				if (auto argument = state_argument(region, output->type()))
+					input->divert_to(argument);
+			}
+		}
+
+		if (s.ref && !s.mod)
+			readers.insert(&node);
+	}
+
+	/* chains of loads and read-only calls share the memory state entering the chain */
+	fanout_readers(region, [&](const jive::node * node){ return memstate(node, readers); });
+}
+
+static void
+modref(jive::region * region, summarymap & summaries)
+{
+	for (const auto & node : jive::topdown_traverser(region)) {
+		if (is<lambda_op>(node)) {
+			auto subregion = static_cast<lambda_node*>(node)->subregion();
+			rewire_calls(subregion, summaries);
+			summaries.insert({node, summarize(subregion, summaries)});
+			continue;
+		}
+
+		if (dynamic_cast<const jive::phi_op*>(&node->operation())) {
+			/* calls between the lambdas of a phi go through recursion variables */
+			modref(static_cast<jive::structural_node*>(node)->subregion(0), summaries);
+		}
+	}
+}
+
+void
+modref(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef MRSTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	summarymap summaries;
+	modref(root, summaries);
+
+	#ifdef MRSTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "MRSTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
@@ -0,0 +1,500 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/opt/narrowing.hpp>
+
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/constant.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+#ifdef NRWTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+static inline uint64_t
+lowmask(size_t nbits)
+{
+	return nbits >= 64 ? ~uint64_t(0) : (uint64_t(1) << nbits) - 1;
+}
+
+static inline size_t
+nbits(const jive::output * output)
+{
+	auto type = dynamic_cast<const jive::bittype*>(&output->type());
+	return type && type->nbits() <= 64 ? type->nbits() : 0;
+}
+
+/* number of trailing and leading bits that are set in a mask of the given width */
+static inline size_t
+ntrailing(uint64_t mask, size_t n)
+{
+	size_t c = 0;
+	while (c < n && (mask & (uint64_t(1) << c)))
+		c++;
+	return c;
+}
+
+static inline size_t
+nleading(uint64_t mask, size_t n)
+{
+	size_t c = 0;
+	while (c < n && (mask & (uint64_t(1) << (n-c-1))))
+		c++;
+	return c;
+}
+
+/* the width needed to hold the highest bit of a mask */
+static inline size_t
+width(uint64_t mask)
+{
+	size_t w = 0;
+	while (w < 64 && (mask >> w) != 0)
+		w++;
+	return w;
+}
+
+/* known bits */
+
+class knownbits final {
+public:
+	inline
+	knownbits(uint64_t zeros, uint64_t ones)
+	: zeros(zeros)
+	, ones(ones)
+	{}
+
+	static inline knownbits
+	unknown()
+	{
+		return knownbits(0, 0);
+	}
+
+	inline knownbits
+	intersect(const knownbits & other) const noexcept
+	{
+		return knownbits(zeros & other.zeros, ones & other.ones);
+	}
+
+	uint64_t zeros;
+	uint64_t ones;
+};
+
+class nrwctx final {
+public:
+	inline knownbits
+	known(const jive::output * output) const
+	{
+		auto it = known_.find(output);
+		return it != known_.end() ? it->second : knownbits::unknown();
+	}
+
+	inline void
+	set_known(const jive::output * output, const knownbits & k)
+	{
+		if (nbits(output) != 0)
+			known_.insert({output, k});
+	}
+
+	inline uint64_t
+	demanded(const jive::output * output) const
+	{
+		auto it = demanded_.find(output);
+		return it != demanded_.end() ? it->second : lowmask(nbits(output));
+	}
+
+	inline void
+	set_demanded(const jive::output * output, uint64_t mask)
+	{
+		if (nbits(output) != 0)
+			demanded_[output] = mask;
+	}
+
+private:
+	std::unordered_map<const jive::output*, knownbits> known_;
+	std::unordered_map<const jive::output*, uint64_t> demanded_;
+};
+
+static inline const jive::bitconstant_op *
+constant(const jive::output * output)
+{
+	auto node = output->node();
+	auto op = node ? dynamic_cast<const jive::bitconstant_op*>(&node->operation()) : nullptr;
+	return op && op->value().is_defined() && op->value().nbits() <= 64 ? op : nullptr;
+}
+
+/* the value of a constant shift amount, or the width of the operand otherwise */
+static inline size_t
+shift_amount(const jive::output * output, size_t n)
+{
+	auto c = constant(output);
+	return c && c->value().to_uint() < n ? c->value().to_uint() : n;
+}
+
+static knownbits
+compute_known(const jive::node * node, const nrwctx & ctx)
+{
+	auto n = nbits(node->output(0));
+	auto mask = lowmask(n);
+
+	if (auto c = constant(node->output(0)))
+		return knownbits(~c->value().to_uint() & mask, c->value().to_uint());
+
+	std::vector<knownbits> ks;
+	for (size_t i = 0; i < node->ninputs(); i++)
+		ks.push_back(ctx.known(node->input(i)->origin()));
+
+	if (auto op = dynamic_cast<const zext_op*>(&node->operation()))
+		return knownbits(ks[0].zeros | (mask & ~lowmask(op->nsrcbits())), ks[0].ones);
+
+	if (auto op = dynamic_cast<const sext_op*>(&node->operation())) {
+		auto sign = uint64_t(1) << (op->nsrcbits()-1);
+		auto high = mask & ~lowmask(op->nsrcbits());
+		return knownbits(ks[0].zeros | (ks[0].zeros & sign ? high : 0),
+			ks[0].ones | (ks[0].ones & sign ? high : 0));
+	}
+
+	if (is<trunc_op>(node))
+		return knownbits(ks[0].zeros & mask, ks[0].ones & mask);
+
+	if (jive::is<jive::bitand_op>(node))
+		return knownbits(ks[0].zeros | ks[1].zeros, ks[0].ones & ks[1].ones);
+
+	if (jive::is<jive::bitor_op>(node))
+		return knownbits(ks[0].zeros & ks[1].zeros, ks[0].ones | ks[1].ones);
+
+	if (jive::is<jive::bitxor_op>(node)) {
+		auto known = (ks[0].zeros | ks[0].ones) & (ks[1].zeros | ks[1].ones);
+		auto ones = (ks[0].ones ^ ks[1].ones) & known;
+		return knownbits(known & ~ones, ones);
+	}
+
+	if (jive::is<jive::bitshl_op>(node)) {
+		auto k = shift_amount(node->input(1)->origin(), n);
+		if (k == n)
+			return knownbits::unknown();
+		return knownbits(((ks[0].zeros << k) | lowmask(k)) & mask, (ks[0].ones << k) & mask);
+	}
+
+	if (jive::is<jive::bitshr_op>(node)) {
+		auto k = shift_amount(node->input(1)->origin(), n);
+		if (k == n)
+			return knownbits::unknown();
+		return knownbits((ks[0].zeros >> k) | (mask & ~lowmask(n-k)), ks[0].ones >> k);
+	}
+
+	/* sums keep the common trailing zeros and grow by at most one bit */
+	if (jive::is<jive::bitadd_op>(node)) {
+		auto tz = std::min(ntrailing(ks[0].zeros, n), ntrailing(ks[1].zeros, n));
+		auto lz = std::min(nleading(ks[0].zeros, n), nleading(ks[1].zeros, n));
+		auto high = lz > 0 ? mask & ~lowmask(n-lz+1) : 0;
+		return knownbits(lowmask(tz) | high, 0);
+	}
+
+	/* products add the trailing zeros and the widths of their operands */
+	if (jive::is<jive::bitmul_op>(node)) {
+		auto tz = std::min(n, ntrailing(ks[0].zeros, n) + ntrailing(ks[1].zeros, n));
+		auto w = (n - nleading(ks[0].zeros, n)) + (n - nleading(ks[1].zeros, n));
+		auto high = w < n ? mask & ~lowmask(w) : 0;
+		return knownbits(lowmask(tz) | high, 0);
+	}
+
+	return knownbits::unknown();
+}
+
+static void
+compute_known(const jive::region * region, nrwctx & ctx)
+{
+	for (const auto & node : jive::topdown_traverser(const_cast<jive::region*>(region))) {
+		if (auto gamma = dynamic_cast<const jive::gamma_node*>(node)) {
+			for (auto ev = gamma->begin_entryvar(); ev != gamma->end_entryvar(); ev++) {
+				for (size_t n = 0; n < ev->narguments(); n++)
+					ctx.set_known(ev->argument(n), ctx.known(ev->origin()));
+			}
+
+			for (size_t n = 0; n < gamma->nsubregions(); n++)
+				compute_known(gamma->subregion(n), ctx);
+
+			for (size_t n = 0; n < gamma->noutputs(); n++) {
+				auto k = ctx.known(gamma->subregion(0)->result(n)->origin());
+				for (size_t r = 1; r < gamma->nsubregions(); r++)
+					k = k.intersect(ctx.known(gamma->subregion(r)->result(n)->origin()));
+				ctx.set_known(gamma->output(n), k);
+			}
+			continue;
+		}
+
+		/* the arguments of all other structural nodes are unknown */
+		if (auto structnode = dynamic_cast<const jive::structural_node*>(node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				compute_known(structnode->subregion(n), ctx);
+			continue;
+		}
+
+		if (node->noutputs() == 1 && nbits(node->output(0)) != 0)
+			ctx.set_known(node->output(0), compute_known(node, ctx));
+	}
+}
+
+/* demanded bits */
+
+/*
+	Returns the bits of the origin of \p input that are demanded by its user.
+*/
+static uint64_t
+demanded_by(const jive::input * input, const nrwctx & ctx)
+{
+	auto node = input->node();
+	auto all = lowmask(nbits(input->origin()));
+	if (!node || !dynamic_cast<const jive::simple_op*>(&node->operation())
+	|| node->noutputs() != 1 || nbits(node->output(0)) == 0)
+		return all;
+
+	auto n = nbits(node->output(0));
+	auto d = ctx.demanded(node->output(0));
+
+	if (is<trunc_op>(node))
+		return d;
+
+	if (auto op = dynamic_cast<const zext_op*>(&node->operation()))
+		return d & lowmask(op->nsrcbits());
+
+	if (auto op = dynamic_cast<const sext_op*>(&node->operation())) {
+		auto sign = (d & ~lowmask(op->nsrcbits())) ? uint64_t(1) << (op->nsrcbits()-1) : 0;
+		return (d & lowmask(op->nsrcbits())) | sign;
+	}
+
+	auto other = node->ninputs() == 2 ? node->input(1 - input->index())->origin() : nullptr;
+	if (jive::is<jive::bitand_op>(node)) {
+		auto c = constant(other);
+		return c ? d & c->value().to_uint() : d;
+	}
+
+	if (jive::is<jive::bitor_op>(node)) {
+		auto c = constant(other);
+		return c ? d & ~c->value().to_uint() : d;
+	}
+
+	if (jive::is<jive::bitxor_op>(node))
+		return d;
+
+	/* the low bits of sums and products only depend on the low bits of their operands */
+	if (jive::is<jive::bitadd_op>(node) || jive::is<jive::bitsub_op>(node)
+	|| jive::is<jive::bitmul_op>(node))
+		return lowmask(width(d));
+
+	if (input->index() == 0 && jive::is<jive::bitshl_op>(node)) {
+		auto k = shift_amount(node->input(1)->origin(), n);
+		return k == n ? all : d >> k;
+	}
+
+	if (input->index() == 0 && jive::is<jive::bitshr_op>(node)) {
+		auto k = shift_amount(node->input(1)->origin(), n);
+		return k == n ? all : (d << k) & all;
+	}
+
+	return all;
+}
+
+static void
+compute_demanded(const jive::region * region, nrwctx & ctx)
+{
+	for (const auto & node : jive::bottomup_traverser(const_cast<jive::region*>(region))) {
+		if (auto structnode = dynamic_cast<const jive::structural_node*>(node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				compute_demanded(structnode->subregion(n), ctx);
+			continue;
+		}
+
+		for (size_t n = 0; n < node->noutputs(); n++) {
+			auto output = node->output(n);
+			if (nbits(output) == 0)
+				continue;
+
+			uint64_t d = 0;
+			for (const auto & user : *output)
+				d |= demanded_by(user, ctx);
+			ctx.set_demanded(output, d);
+		}
+	}
+}
+
+/* transformation */
+
+static bool
+is_narrowable_operand(const jive::output * output, size_t m)
+{
+	if (constant(output))
+		return true;
+
+	auto node = output->node();
+	if (auto op = node ? dynamic_cast<const zext_op*>(&node->operation()) : nullptr)
+		return op->nsrcbits() <= m;
+
+	if (auto op = node ? dynamic_cast<const sext_op*>(&node->operation()) : nullptr)
+		return op->nsrcbits() <= m;
+
+	return false;
+}
+
+static bool
+narrow_arithmetic(jive::node * node, const nrwctx & ctx)
+{
+	auto op = dynamic_cast<const jive::bitbinary_op*>(&node->operation());
+	if (!op || node->ninputs() != 2)
+		return false;
+
+	if (!jive::is<jive::bitadd_op>(node) && !jive::is<jive::bitsub_op>(node)
+	&& !jive::is<jive::bitmul_op>(node) && !jive::is<jive::bitand_op>(node)
+	&& !jive::is<jive::bitor_op>(node) && !jive::is<jive::bitxor_op>(node))
+		return false;
+
+	auto output = node->output(0);
+	auto n = nbits(output);
+	auto w = width(ctx.demanded(output));
+
+	size_t m = 8;
+	while (m < w)
+		m *= 2;
+	if (n == 0 || m >= n)
+		return false;
+
+	auto op1 = node->input(0)->origin();
+	auto op2 = node->input(1)->origin();
+	if (!is_narrowable_operand(op1, m) || !is_narrowable_operand(op2, m))
+		return false;
+
+	auto region = node->region();
+	auto nop = op->create(m);
+	auto result = jive::simple_node::create_normalized(region, *nop,
+		{create_trunc(m, op1), create_trunc(m, op2)})[0];
+	output->divert_users(create_zext(n, result));
+	return true;
+}
+
+/*
+	Rewrites that rely on known bits. They preserve the values of all outputs, such that
+	the known bits stay valid while the region is rewritten.
+*/
+static void
+simplify_known(jive::node * node, const nrwctx & ctx)
+{
+	/* masks that only clear known zero bits */
+	if (jive::is<jive::bitand_op>(node)) {
+		for (size_t n = 0; n < 2; n++) {
+			auto c = constant(node->input(n)->origin());
+			auto x = node->input(1-n)->origin();
+			if (!c)
+				continue;
+
+			auto cleared = ~c->value().to_uint() & lowmask(nbits(x));
+			if ((cleared & ~ctx.known(x).zeros) == 0) {
+				node->output(0)->divert_users(x);
+				return;
+			}
+		}
+	}
+
+	/* sign extensions of values with a known zero sign bit */
+	if (auto op = dynamic_cast<const sext_op*>(&node->operation())) {
+		auto x = node->input(0)->origin();
+		if (ctx.known(x).zeros & (uint64_t(1) << (op->nsrcbits()-1)))
+			node->output(0)->divert_users(create_zext(op->ndstbits(), x));
+	}
+}
+
+/*
+	Rewrites that rely on demanded bits. They only change bits that are not demanded, which
+	invalidates known bits but not the demanded bits of other outputs.
+*/
+static void
+simplify_demanded(jive::node * node, const nrwctx & ctx)
+{
+	/* masks that only clear undemanded bits */
+	if (jive::is<jive::bitand_op>(node)) {
+		for (size_t n = 0; n < 2; n++) {
+			auto c = constant(node->input(n)->origin());
+			auto x = node->input(1-n)->origin();
+			if (!c)
+				continue;
+
+			auto cleared = ~c->value().to_uint() & lowmask(nbits(x));
+			if ((cleared & ctx.demanded(node->output(0))) == 0) {
+				node->output(0)->divert_users(x);
+				return;
+			}
+		}
+	}
+
+	narrow_arithmetic(node, ctx);
+}
+
+static void
+transform(
+	jive::region * region,
+	const nrwctx & ctx,
+	void(*simplify)(jive::node*, const nrwctx&))
+{
+	std::vector<jive::node*> nodes;
+	for (const auto & node : jive::topdown_traverser(region))
+		nodes.push_back(node);
+
+	for (const auto & node : nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				transform(structnode->subregion(n), ctx, simplify);
+			continue;
+		}
+
+		/* nodes that became dead in an earlier sweep are left to dead node elimination */
+		if (node->noutputs() == 1 && nbits(node->output(0)) != 0 && node->output(0)->nusers() != 0)
+			simplify(node, ctx);
+	}
+}
+
+void
+narrow(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef NRWTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	/*
+		The known bits are computed on the unmodified graph and used before any rewrite
+		based on demanded bits changes values.
+	*/
+	{
+		nrwctx ctx;
+		compute_known(root, ctx);
+		transform(root, ctx, simplify_known);
+	}
+
+	{
+		nrwctx ctx;
+		compute_demanded(root, ctx);
+		transform(root, ctx, simplify_demanded);
+	}
+
+	#ifdef NRWTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "NRWTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
@@ -6,15 +6,36 @@
 #include <jlm/ir/rvsdg.hpp>
 
 #include <jlm/opt/cne.hpp>
+#include <jlm/opt/constload.hpp>
+#include <jlm/opt/devirtualization.hpp>
 #include <jlm/opt/dne.hpp>
+#include <jlm/opt/dse.hpp>
+#include <jlm/opt/fanout.hpp>
+#include <jlm/opt/forwarding.hpp>
+#include <jlm/opt/heap2stack.hpp>
+#include <jlm/opt/ifconversion.hpp>
 #include <jlm/opt/inlining.hpp>
 #include <jlm/opt/invariance.hpp>
+#include <jlm/opt/ipcp.hpp>
 #include <jlm/opt/inversion.hpp>
+#include <jlm/opt/loopdeletion.hpp>
+#include <jlm/opt/mem2reg.hpp>
+#include <jlm/opt/memexpand.hpp>
+#include <jlm/opt/modref.hpp>
+#include <jlm/opt/narrowing.hpp>
 #include <jlm/opt/optimization.hpp>
+#include <jlm/opt/peeling.hpp>
+#include <jlm/opt/pointsto.hpp>
 #include <jlm/opt/pull.hpp>
 #include <jlm/opt/push.hpp>
+#include <jlm/opt/reassociation.hpp>
 #include <jlm/opt/reduction.hpp>
+#include <jlm/opt/sccp.hpp>
+#include <jlm/opt/sra.hpp>
+#include <jlm/opt/tailrecursion.hpp>
 #include <jlm/opt/unroll.hpp>
+#include <jlm/opt/unswitch.hpp>
+#include <jlm/opt/vra.hpp>
 
 #include <jlm/util/stats.hpp>
 #include <jlm/util/time.hpp>
@@ -36,6 +57,27 @@ optimize(jlm::rvsdg & rvsdg, const optimization & opt)
 	, {optimization::ivt, [](jive::graph & graph){ jlm::invert(graph); }}
 	, {optimization::url, [](jive::graph & graph){ jlm::unroll(graph, 4); }}
 	, {optimization::red, [](jive::graph & graph){ jlm::reduce(graph); }}
+	, {optimization::usw, [](jive::graph & graph){ jlm::unswitch(graph, 500); }}
+	, {optimization::ldl, [](jive::graph & graph){ jlm::delete_loops(graph); }}
+	, {optimization::tre, [](jive::graph & graph){ jlm::eliminate_tail_recursion(graph); }}
+	, {optimization::pel, [](jive::graph & graph){ jlm::peel(graph, 500); }}
+	, {optimization::pts, [](jive::graph & graph){ jlm::split_memory_states(graph); }}
+	, {optimization::m2r, [](jive::graph & graph){ jlm::mem2reg(graph); }}
+	, {optimization::dse, [](jive::graph & graph){ jlm::dse(graph); }}
+	, {optimization::slf, [](jive::graph & graph){ jlm::forward_stores(graph); }}
+	, {optimization::sra, [](jive::graph & graph){ jlm::sra(graph); }}
+	, {optimization::clf, [](jive::graph & graph){ jlm::fold_constant_loads(graph); }}
+	, {optimization::h2s, [](jive::graph & graph){ jlm::heap2stack(graph); }}
+	, {optimization::lsf, [](jive::graph & graph){ jlm::fanout_loads(graph); }}
+	, {optimization::mrs, [](jive::graph & graph){ jlm::modref(graph); }}
+	, {optimization::mex, [](jive::graph & graph){ jlm::expand_memops(graph); }}
+	, {optimization::scp, [](jive::graph & graph){ jlm::sccp(graph); }}
+	, {optimization::icp, [](jive::graph & graph){ jlm::ipcp(graph); }}
+	, {optimization::ras, [](jive::graph & graph){ jlm::reassociate(graph); }}
+	, {optimization::ifc, [](jive::graph & graph){ jlm::ifconvert(graph); }}
+	, {optimization::vra, [](jive::graph & graph){ jlm::vra(graph); }}
+	, {optimization::nrw, [](jive::graph & graph){ jlm::narrow(graph); }}
+	, {optimization::dvt, [](jive::graph & graph){ jlm::devirtualize(graph); }}
 	});
 
 
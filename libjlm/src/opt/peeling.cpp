@@ -0,0 +1,173 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/opt/peeling.hpp>
+
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/simple-node.h>
+#include <jive/rvsdg/substitution.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+
+#ifdef PELTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+static jive::theta_node *
+peel(jive::theta_node * otheta)
+{
+	/* copy first iteration in front of theta */
+	jive::substitution_map smap;
+	for (const auto & olv : *otheta)
+		smap.insert(olv->argument(), olv->input()->origin());
+	otheta->subregion()->copy(otheta->region(), smap, false, false);
+
+	/* execute remaining iterations only if the loop repeats */
+	auto gamma = jive::gamma_node::create(smap.lookup(otheta->predicate()->origin()), 2);
+	auto ntheta = jive::theta_node::create(gamma->subregion(1));
+
+	jive::substitution_map rmap;
+	std::vector<jive::gamma_input*> evs;
+	for (const auto & olv : *otheta) {
+		auto ev = gamma->add_entryvar(smap.lookup(olv->result()->origin()));
+		auto nlv = ntheta->add_loopvar(ev->argument(1));
+		rmap.insert(olv->argument(), nlv->argument());
+		evs.push_back(ev);
+	}
+
+	otheta->subregion()->copy(ntheta->subregion(), rmap, false, false);
+	ntheta->set_predicate(rmap.lookup(otheta->predicate()->origin()));
+
+	size_t n = 0;
+	for (auto olv = otheta->begin(), nlv = ntheta->begin(); olv != otheta->end(); olv++, nlv++) {
+		(*nlv)->result()->divert_to(rmap.lookup((*olv)->result()->origin()));
+		(*olv)->divert_users(gamma->add_exitvar({evs[n++]->argument(0), *nlv}));
+	}
+
+	remove(otheta);
+	return ntheta;
+}
+
+jive::theta_node *
+peel(jive::theta_node * theta, size_t niterations)
+{
+	for (size_t n = 0; n < niterations; n++)
+		theta = peel(theta);
+
+	return theta;
+}
+
+static bool
+is_invariant(const jive::argument * argument)
+{
+	auto theta = static_cast<const jive::theta_node*>(argument->region()->node());
+	JLM_DEBUG_ASSERT(jive::is<jive::theta_op>(theta));
+	return jive::is_invariant(theta->output(argument->index()));
+}
+
+/*
+	Determines whether an output of a theta subregion has the same value in every
+	iteration, i.e., it is only computed from constants and invariant loop variables.
+*/
+static bool
+is_invariant_value(
+	const jive::output * output,
+	std::unordered_map<const jive::output*, bool> & cache)
+{
+	if (cache.find(output) != cache.end())
+		return cache[output];
+
+	bool invariant = true;
+	if (auto argument = dynamic_cast<const jive::argument*>(output)) {
+		invariant = is_invariant(argument);
+	} else if (!dynamic_cast<const jive::simple_node*>(output->node())) {
+		invariant = false;
+	} else {
+		auto node = output->node();
+		for (size_t n = 0; n < node->noutputs() && invariant; n++) {
+			if (dynamic_cast<const jive::statetype*>(&node->output(n)->type()))
+				invariant = false;
+		}
+
+		for (size_t n = 0; n < node->ninputs() && invariant; n++)
+			invariant = is_invariant_value(node->input(n)->origin(), cache);
+	}
+
+	cache[output] = invariant;
+	return invariant;
+}
+
+static std::vector<size_t>
+collect_first_iteration_variables(const jive::theta_node * theta)
+{
+	std::vector<size_t> indices;
+	std::unordered_map<const jive::output*, bool> cache;
+	for (const auto & lv : *theta) {
+		if (lv->result()->origin() == lv->argument())
+			continue;
+
+		if (is_invariant_value(lv->result()->origin(), cache))
+			indices.push_back(lv->index());
+	}
+
+	return indices;
+}
+
+static void
+peel(jive::region * region, size_t budget)
+{
+	for (auto & node : jive::topdown_traverser(region)) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				peel(structnode->subregion(n), budget);
+
+			auto theta = dynamic_cast<jive::theta_node*>(node);
+			if (!theta || jive::nnodes(theta->subregion()) > budget)
+				continue;
+
+			auto indices = collect_first_iteration_variables(theta);
+			if (indices.empty())
+				continue;
+
+			/*
+				After the first iteration, the values of these loop variables are computed
+				from the same invariant values in every iteration. They are therefore
+				invariant in the remaining loop.
+			*/
+			auto ntheta = peel(theta, 1);
+			for (const auto & index : indices) {
+				auto lv = ntheta->output(index);
+				lv->result()->divert_to(lv->argument());
+			}
+		}
+	}
+}
+
+void
+peel(jive::graph & rvsdg, size_t budget)
+{
+	auto root = rvsdg.root();
+
+	#ifdef PELTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	peel(root, budget);
+
+	#ifdef PELTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "PELTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
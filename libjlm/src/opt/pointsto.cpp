@@ -0,0 +1,459 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/pointsto.hpp>
+
+#include <jive/arch/addresstype.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/phi.h>
+#include <jive/rvsdg/statemux.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+
+#ifdef PTSTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+/* location class */
+
+class pointsto::location final {
+public:
+	inline
+	location()
+	: unknown(false)
+	, parent(this)
+	, target(nullptr)
+	{}
+
+	inline const location *
+	root() const noexcept
+	{
+		auto l = this;
+		while (l->parent != l)
+			l = l->parent;
+
+		return l;
+	}
+
+	inline location *
+	find() noexcept
+	{
+		if (parent != this)
+			parent = parent->find();
+
+		return parent;
+	}
+
+	bool unknown;
+	location * parent;
+	location * target;
+};
+
+/* pointsto class */
+
+pointsto::~pointsto()
+{}
+
+pointsto::pointsto()
+: unknown_(nullptr)
+{
+	unknown_ = create_location();
+	unknown_->unknown = true;
+	unknown_->target = unknown_;
+}
+
+pointsto::location *
+pointsto::create_location()
+{
+	locations_.push_back(std::make_unique<location>());
+	return locations_.back().get();
+}
+
+pointsto::location *
+pointsto::lookup(const jive::output * pointer)
+{
+	JLM_DEBUG_ASSERT(is<ptrtype>(pointer->type()));
+
+	auto it = map_.find(pointer);
+	if (it != map_.end())
+		return it->second->find();
+
+	auto l = create_location();
+	map_[pointer] = l;
+	return l;
+}
+
+pointsto::location *
+pointsto::target(location * l)
+{
+	l = l->find();
+	if (!l->target)
+		l->target = create_location();
+
+	return l->target->find();
+}
+
+void
+pointsto::unify(location * l1, location * l2)
+{
+	l1 = l1->find();
+	l2 = l2->find();
+	if (l1 == l2)
+		return;
+
+	/* keep the unknown class as representative */
+	if (l2 == unknown_)
+		std::swap(l1, l2);
+
+	auto t1 = l1->target;
+	auto t2 = l2->target;
+	l2->parent = l1;
+	l1->unknown = l1->unknown || l2->unknown;
+	l1->target = t1 ? t1 : t2;
+
+	if (t1 && t2)
+		unify(t1, t2);
+}
+
+void
+pointsto::unify(const jive::output * p1, const jive::output * p2)
+{
+	if (is<ptrtype>(p1->type()) && is<ptrtype>(p2->type()))
+		unify(lookup(p1), lookup(p2));
+}
+
+void
+pointsto::escape(const jive::output * pointer)
+{
+	if (is<ptrtype>(pointer->type()))
+		unify(lookup(pointer), unknown_);
+}
+
+void
+pointsto::analyze_simple(const jive::node * node)
+{
+	if (is<alloca_op>(node)) {
+		/* fresh location */
+		lookup(node->output(0));
+		return;
+	}
+
+	if (is<getelementptr_op>(node) || is<bitcast_op>(node)) {
+		unify(node->output(0), node->input(0)->origin());
+		if (!is<ptrtype>(node->output(0)->type()))
+			escape(node->input(0)->origin());
+		if (!is<ptrtype>(node->input(0)->type()))
+			escape(node->output(0));
+		return;
+	}
+
+	if (is<select_op>(node)) {
+		unify(node->output(0), node->input(1)->origin());
+		unify(node->output(0), node->input(2)->origin());
+		return;
+	}
+
+	if (is<load_op>(node)) {
+		auto address = node->input(0)->origin();
+		if (is<ptrtype>(node->output(0)->type()))
+			unify(lookup(node->output(0)), target(lookup(address)));
+		return;
+	}
+
+	if (is<store_op>(node)) {
+		auto address = node->input(0)->origin();
+		auto value = node->input(1)->origin();
+		if (is<ptrtype>(value->type()))
+			unify(target(lookup(address)), lookup(value));
+		return;
+	}
+
+	/* the pointers stored in the source are copied to the destination */
+	if (is<memcpy_op>(node)) {
+		auto destination = node->input(0)->origin();
+		auto source = node->input(1)->origin();
+		unify(target(lookup(destination)), target(lookup(source)));
+		return;
+	}
+
+	if (is<ptrcmp_op>(node) || is<memset_op>(node))
+		return;
+
+	if (is<ptr_constant_null_op>(node) || is<undef_constant_op>(node)) {
+		if (is<ptrtype>(node->output(0)->type()))
+			lookup(node->output(0));
+		return;
+	}
+
+	/*
+		All other operations, including calls, might create pointers we know nothing about,
+		or let pointers escape.
+	*/
+	for (size_t n = 0; n < node->ninputs(); n++)
+		escape(node->input(n)->origin());
+	for (size_t n = 0; n < node->noutputs(); n++)
+		escape(node->output(n));
+}
+
+void
+pointsto::analyze_structural(const jive::node * node)
+{
+	auto snode = static_cast<const jive::structural_node*>(node);
+
+	for (size_t n = 0; n < snode->ninputs(); n++) {
+		auto input = snode->input(n);
+		for (const auto & argument : input->arguments)
+			unify(&argument, input->origin());
+	}
+
+	for (size_t n = 0; n < snode->noutputs(); n++) {
+		auto output = snode->output(n);
+		for (const auto & result : output->results)
+			unify(output, result.origin());
+	}
+
+	if (auto theta = dynamic_cast<const jive::theta_node*>(node)) {
+		for (const auto & lv : *theta)
+			unify(lv->argument(), lv->result()->origin());
+	} else if (is<lambda_op>(node)) {
+		auto subregion = snode->subregion(0);
+		for (size_t n = 0; n < subregion->narguments(); n++) {
+			if (subregion->argument(n)->input() == nullptr)
+				escape(subregion->argument(n));
+		}
+		for (size_t n = 0; n < subregion->nresults(); n++)
+			escape(subregion->result(n)->origin());
+		lookup(node->output(0));
+	} else if (dynamic_cast<const jive::phi_op*>(&node->operation())) {
+		auto subregion = snode->subregion(0);
+		for (size_t n = 0; n < subregion->narguments(); n++) {
+			auto argument = subregion->argument(n);
+			if (argument->input() == nullptr)
+				unify(argument, subregion->result(argument->index())->origin());
+		}
+	} else if (is<delta_op>(node)) {
+		auto value = snode->subregion(0)->result(0)->origin();
+		if (is<ptrtype>(value->type()))
+			unify(target(lookup(node->output(0))), lookup(value));
+	}
+
+	for (size_t n = 0; n < snode->nsubregions(); n++)
+		analyze(snode->subregion(n));
+}
+
+void
+pointsto::analyze(const jive::region * region)
+{
+	for (const auto & node : region->nodes) {
+		if (dynamic_cast<const jive::simple_node*>(&node))
+			analyze_simple(&node);
+		else
+			analyze_structural(&node);
+	}
+}
+
+const pointsto::location *
+pointsto::memclass(const jive::output * pointer) const
+{
+	auto it = map_.find(pointer);
+	if (it == map_.end())
+		return unknown_;
+
+	return it->second->root();
+}
+
+bool
+pointsto::is_unknown(const location * l) const noexcept
+{
+	return l->root()->unknown;
+}
+
+bool
+pointsto::may_alias(const jive::output * p1, const jive::output * p2) const
+{
+	auto l1 = memclass(p1);
+	auto l2 = memclass(p2);
+	return l1 == l2 || is_unknown(l1) || is_unknown(l2);
+}
+
+std::unique_ptr<pointsto>
+pointsto::analyze(const jive::graph & graph)
+{
+	std::unique_ptr<pointsto> pt(new pointsto());
+
+	auto root = graph.root();
+	for (size_t n = 0; n < root->narguments(); n++)
+		pt->escape(root->argument(n));
+
+	pt->analyze(root);
+
+	for (size_t n = 0; n < root->nresults(); n++)
+		pt->escape(root->result(n)->origin());
+
+	return pt;
+}
+
+/* memory state splitting */
+
+static bool
+is_chainable(const jive::node * node)
+{
+	if (auto op = dynamic_cast<const load_op*>(&node->operation()))
+		return op->nstates() == 1;
+
+	if (auto op = dynamic_cast<const store_op*>(&node->operation()))
+		return op->nstates() == 1;
+
+	return false;
+}
+
+static jive::input *
+state_input(const jive::node * node)
+{
+	JLM_DEBUG_ASSERT(is_chainable(node));
+	return is<load_op>(node) ? node->input(1) : node->input(2);
+}
+
+static jive::output *
+state_output(const jive::node * node)
+{
+	JLM_DEBUG_ASSERT(is_chainable(node));
+	return is<load_op>(node) ? node->output(1) : node->output(0);
+}
+
+static bool
+is_chain_link(const jive::output * output)
+{
+	auto node = output->node();
+	if (!node || !is_chainable(node))
+		return false;
+
+	return output == state_output(node) && output->nusers() == 1;
+}
+
+static std::vector<jive::node*>
+collect_chain(jive::node * head)
+{
+	std::vector<jive::node*> chain({head});
+	while (true) {
+		auto output = state_output(chain.back());
+		if (output->nusers() != 1)
+			break;
+
+		auto user = *output->begin();
+		auto node = user->node();
+		if (!node || !is_chainable(node) || state_input(node) != user)
+			break;
+
+		chain.push_back(node);
+	}
+
+	return chain;
+}
+
+static jive::output *
+join(
+	jive::output * state,
+	const std::vector<const pointsto::location*> & classes,
+	const std::unordered_map<const pointsto::location*, jive::output*> & last)
+{
+	if (classes.empty())
+		return state;
+
+	if (classes.size() == 1)
+		return last.at(classes[0]);
+
+	std::vector<jive::output*> states;
+	for (const auto & c : classes)
+		states.push_back(last.at(c));
+
+	return jive::create_state_mux(state->type(), states, 1)[0];
+}
+
+static void
+split_chain(const std::vector<jive::node*> & chain, const pointsto & pt)
+{
+	auto state = state_input(chain[0])->origin();
+
+	std::vector<jive::input*> users;
+	for (const auto & user : *state_output(chain.back()))
+		users.push_back(user);
+
+	std::vector<const pointsto::location*> classes;
+	std::unordered_map<const pointsto::location*, jive::output*> last;
+	for (const auto & node : chain) {
+		auto c = pt.memclass(node->input(0)->origin());
+
+		if (pt.is_unknown(c)) {
+			state_input(node)->divert_to(join(state, classes, last));
+			state = state_output(node);
+			classes.clear();
+			last.clear();
+			continue;
+		}
+
+		auto it = last.find(c);
+		state_input(node)->divert_to(it != last.end() ? it->second : state);
+		if (it == last.end())
+			classes.push_back(c);
+		last[c] = state_output(node);
+	}
+
+	auto origin = join(state, classes, last);
+	for (const auto & user : users)
+		user->divert_to(origin);
+}
+
+static void
+split_memory_states(jive::region * region, const pointsto & pt)
+{
+	std::vector<std::vector<jive::node*>> chains;
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				split_memory_states(structnode->subregion(n), pt);
+			continue;
+		}
+
+		if (is_chainable(&node) && !is_chain_link(state_input(&node)->origin())) {
+			auto chain = collect_chain(&node);
+			if (chain.size() > 1)
+				chains.push_back(chain);
+		}
+	}
+
+	for (const auto & chain : chains)
+		split_chain(chain, pt);
+}
+
+void
+split_memory_states(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef PTSTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	auto pt = pointsto::analyze(rvsdg);
+	split_memory_states(root, *pt);
+
+	#ifdef PTSTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "PTSTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
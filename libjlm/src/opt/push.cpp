@@ -4,6 +4,7 @@
  */
 
 #include <jlm/common.hpp>
+#include <jlm/ir/operators/load.hpp>
 #include <jlm/ir/operators/operators.hpp>
 #include <jlm/ir/operators/store.hpp>
 #include <jlm/opt/push.hpp>
@@ -181,6 +182,65 @@ is_theta_invariant(
 	return true;
 }
 
+static bool
+is_movable_load(
+	const jive::node * node,
+	const std::unordered_set<jive::argument*> & invariants)
+{
+	JLM_DEBUG_ASSERT(jive::is<jive::theta_op>(node->region()->node()));
+	JLM_DEBUG_ASSERT(jive::is<load_op>(node));
+
+	if (!is_theta_invariant(node, invariants))
+		return false;
+
+	/*
+		The consumed states must be invariant loop variables, i.e., no other operation in
+		the loop can modify the memory the load reads from.
+	*/
+	for (size_t n = 1; n < node->ninputs(); n++) {
+		auto argument = static_cast<const jive::argument*>(node->input(n)->origin());
+		if (argument->region()->result(argument->index()+1)->origin() != argument)
+			return false;
+	}
+
+	return true;
+}
+
+static std::vector<jive::argument*>
+pushout_load(jive::node * loadnode)
+{
+	JLM_DEBUG_ASSERT(jive::is<jive::theta_op>(loadnode->region()->node()));
+	JLM_DEBUG_ASSERT(jive::is<load_op>(loadnode));
+	auto theta = static_cast<jive::theta_node*>(loadnode->region()->node());
+
+	std::vector<jive::output*> operands;
+	for (size_t n = 0; n < loadnode->ninputs(); n++) {
+		auto argument = static_cast<const jive::argument*>(loadnode->input(n)->origin());
+		operands.push_back(argument->input()->origin());
+	}
+
+	auto copy = loadnode->copy(theta->region(), operands);
+
+	/* route loaded value into the loop */
+	auto lv = theta->add_loopvar(copy->output(0));
+	loadnode->output(0)->divert_users(lv->argument());
+
+	/*
+		Loads do not modify memory. The states consumed in the loop can therefore be used
+		directly, while the loop itself is sequenced after the hoisted load.
+	*/
+	std::vector<jive::argument*> arguments({lv->argument()});
+	for (size_t n = 1; n < loadnode->ninputs(); n++) {
+		auto argument = static_cast<jive::argument*>(loadnode->input(n)->origin());
+		argument->input()->divert_to(copy->output(n));
+		loadnode->output(n)->divert_users(argument);
+		arguments.push_back(argument);
+	}
+
+	remove(loadnode);
+	return arguments;
+}
+
 void
 push_top(jive::theta_node * theta)
 {
@@ -214,11 +274,16 @@ push_top(jive::theta_node * theta)
 	while (!wl.empty()) {
 		auto node = wl.pop_front();
 
-		/* we cannot push out nodes with side-effects */
-		if (has_side_effects(node))
-			continue;
+		std::vector<jive::argument*> arguments;
+		if (jive::is<load_op>(node) && is_movable_load(node, invariants)) {
+			arguments = pushout_load(node);
+		} else {
+			/* we cannot push out nodes with side-effects */
+			if (has_side_effects(node))
+				continue;
 
-		auto arguments = copy_from_theta(node);
+			arguments = copy_from_theta(node);
+		}
 		invariants.insert(arguments.begin(), arguments.end());
 
 		/* add consumers to worklist */
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/opt/reassociation.hpp>
+
+#include <jive/rvsdg/structural-node.h>
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/constant.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+#ifdef RASTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+/*
+	Ranks are assigned in topdown order. Constants have rank zero, such that they are
+	sorted in front of all other operands.
+*/
+typedef std::unordered_map<const jive::output*, size_t> rankmap;
+
+static inline bool
+is_reassociable(const jive::node * node)
+{
+	auto op = dynamic_cast<const jive::bitbinary_op*>(&node->operation());
+	return op && node->ninputs() == 2 && op->is_associative() && op->is_commutative();
+}
+
+/*
+	Returns true if the origin of \p input is computed by a node that can be merged into
+	the tree of the node of \p input.
+*/
+static bool
+is_inner(const jive::input * input)
+{
+	auto node = input->origin()->node();
+	return node
+	    && input->node()
+	    && input->origin()->nusers() == 1
+	    && node->operation() == input->node()->operation();
+}
+
+static void
+collect_leaves(const jive::node * node, std::vector<jive::output*> & leaves, size_t & ninner)
+{
+	ninner++;
+	for (size_t n = 0; n < node->ninputs(); n++) {
+		auto input = node->input(n);
+		if (is_inner(input))
+			collect_leaves(input->origin()->node(), leaves, ninner);
+		else
+			leaves.push_back(input->origin());
+	}
+}
+
+static inline const jive::bitconstant_op *
+constant(const jive::output * output)
+{
+	auto node = output->node();
+	return node ? dynamic_cast<const jive::bitconstant_op*>(&node->operation()) : nullptr;
+}
+
+static void
+reassociate(jive::node * root, rankmap & ranks)
+{
+	auto region = root->region();
+	auto & op = *static_cast<const jive::bitbinary_op*>(&root->operation());
+
+	size_t ninner = 0;
+	std::vector<jive::output*> leaves;
+	collect_leaves(root, leaves, ninner);
+
+	std::stable_sort(leaves.begin(), leaves.end(),
+		[&](const jive::output * o1, const jive::output * o2) {
+			return ranks[o1] < ranks[o2];
+		});
+
+	/* fold constants and move them to the end of the chain */
+	size_t nconstants = 0;
+	while (nconstants < leaves.size() && constant(leaves[nconstants]))
+		nconstants++;
+
+	std::vector<jive::output*> operands(leaves.begin() + nconstants, leaves.end());
+	if (nconstants == 1) {
+		operands.push_back(leaves[0]);
+	} else if (nconstants > 1) {
+		auto value = constant(leaves[0])->value();
+		for (size_t n = 1; n < nconstants; n++)
+			value = op.reduce_constants(value, constant(leaves[n])->value());
+
+		auto c = jive::create_bitconstant(region, value);
+		ranks[c] = 0;
+		operands.push_back(c);
+	}
+
+	/* the tree is already in canonical form */
+	if (ninner == 1 && operands.size() == 2
+	&& root->input(0)->origin() == operands[0] && root->input(1)->origin() == operands[1])
+		return;
+
+	auto result = operands[0];
+	for (size_t n = 1; n < operands.size(); n++)
+		result = jive::simple_node::create_normalized(region, op, {result, operands[n]})[0];
+
+	ranks[result] = ranks[root->output(0)];
+	root->output(0)->divert_users(result);
+}
+
+static void
+reassociate(jive::region * region, rankmap & ranks, size_t & rank)
+{
+	for (size_t n = 0; n < region->narguments(); n++)
+		ranks[region->argument(n)] = ++rank;
+
+	std::vector<jive::node*> nodes;
+	for (const auto & node : jive::topdown_traverser(region))
+		nodes.push_back(node);
+
+	for (const auto & node : nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				reassociate(structnode->subregion(n), ranks, rank);
+		}
+
+		for (size_t n = 0; n < node->noutputs(); n++)
+			ranks[node->output(n)] = jive::is<jive::bitconstant_op>(node) ? 0 : ++rank;
+
+		if (!is_reassociable(node))
+			continue;
+
+		/* only the roots of trees are rebuilt */
+		auto output = node->output(0);
+		if (output->nusers() == 1 && is_inner(*output->begin()))
+			continue;
+
+		reassociate(node, ranks);
+	}
+}
+
+void
+reassociate(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef RASTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	size_t rank = 0;
+	rankmap ranks;
+	reassociate(root, ranks, rank);
+
+	#ifdef RASTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "RASTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
@@ -0,0 +1,503 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/opt/sccp.hpp>
+
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/substitution.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/comparison.h>
+#include <jive/types/bitstring/constant.h>
+
+#include <memory>
+#include <unordered_map>
+
+#ifdef SCCPTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+/* lattice */
+
+/*
+	top: the output is not (yet) known to be computed
+	constant: the output always has the same bitstring or control value
+	bottom: the output might have different values
+*/
+class lattice final {
+	enum class kind {top, constant, bottom};
+
+	inline
+	lattice(kind k)
+	: kind_(k)
+	, alternative_(0)
+	, nalternatives_(0)
+	{}
+
+public:
+	inline
+	lattice(const lattice & other)
+	: kind_(other.kind_)
+	, alternative_(other.alternative_)
+	, nalternatives_(other.nalternatives_)
+	, bits_(other.bits_ ? std::make_unique<jive::bitvalue_repr>(*other.bits_) : nullptr)
+	{}
+
+	lattice &
+	operator=(const lattice & other)
+	{
+		if (this == &other)
+			return *this;
+
+		kind_ = other.kind_;
+		alternative_ = other.alternative_;
+		nalternatives_ = other.nalternatives_;
+		bits_ = other.bits_ ? std::make_unique<jive::bitvalue_repr>(*other.bits_) : nullptr;
+		return *this;
+	}
+
+	static inline lattice
+	top()
+	{
+		return lattice(kind::top);
+	}
+
+	static inline lattice
+	bottom()
+	{
+		return lattice(kind::bottom);
+	}
+
+	static inline lattice
+	bits(const jive::bitvalue_repr & value)
+	{
+		if (!value.is_defined())
+			return bottom();
+
+		lattice l(kind::constant);
+		l.bits_ = std::make_unique<jive::bitvalue_repr>(value);
+		return l;
+	}
+
+	static inline lattice
+	control(size_t alternative, size_t nalternatives)
+	{
+		lattice l(kind::constant);
+		l.alternative_ = alternative;
+		l.nalternatives_ = nalternatives;
+		return l;
+	}
+
+	inline bool
+	is_top() const noexcept
+	{
+		return kind_ == kind::top;
+	}
+
+	inline bool
+	is_bottom() const noexcept
+	{
+		return kind_ == kind::bottom;
+	}
+
+	inline bool
+	is_bits() const noexcept
+	{
+		return kind_ == kind::constant && bits_;
+	}
+
+	inline bool
+	is_control() const noexcept
+	{
+		return kind_ == kind::constant && !bits_;
+	}
+
+	inline const jive::bitvalue_repr &
+	bits() const noexcept
+	{
+		JLM_DEBUG_ASSERT(is_bits());
+		return *bits_;
+	}
+
+	inline size_t
+	alternative() const noexcept
+	{
+		JLM_DEBUG_ASSERT(is_control());
+		return alternative_;
+	}
+
+	inline size_t
+	nalternatives() const noexcept
+	{
+		JLM_DEBUG_ASSERT(is_control());
+		return nalternatives_;
+	}
+
+	bool
+	operator==(const lattice & other) const noexcept
+	{
+		if (kind_ != other.kind_)
+			return false;
+
+		if (is_bits())
+			return other.is_bits() && bits() == other.bits();
+
+		if (is_control())
+			return other.is_control() && alternative() == other.alternative();
+
+		return true;
+	}
+
+	inline bool
+	operator!=(const lattice & other) const noexcept
+	{
+		return !(*this == other);
+	}
+
+	lattice
+	meet(const lattice & other) const
+	{
+		if (is_top())
+			return other;
+
+		if (other.is_top())
+			return *this;
+
+		return *this == other ? *this : bottom();
+	}
+
+private:
+	kind kind_;
+	size_t alternative_;
+	size_t nalternatives_;
+	std::unique_ptr<jive::bitvalue_repr> bits_;
+};
+
+/* sccp context */
+
+class sccpctx final {
+public:
+	inline lattice
+	value(const jive::output * output) const
+	{
+		auto it = values_.find(output);
+		return it != values_.end() ? it->second : lattice::top();
+	}
+
+	inline void
+	set(const jive::output * output, const lattice & value)
+	{
+		auto it = values_.find(output);
+		if (it != values_.end())
+			it->second = value;
+		else
+			values_.insert({output, value});
+	}
+
+private:
+	std::unordered_map<const jive::output*, lattice> values_;
+};
+
+/* analysis */
+
+static lattice
+evaluate_simple(const jive::node * node, const sccpctx & ctx)
+{
+	auto & op = node->operation();
+	if (auto cop = dynamic_cast<const jive::bitconstant_op*>(&op))
+		return lattice::bits(cop->value());
+
+	if (auto cop = dynamic_cast<const jive::ctlconstant_op*>(&op))
+		return lattice::control(cop->value().alternative(), cop->value().nalternatives());
+
+	std::vector<lattice> operands;
+	for (size_t n = 0; n < node->ninputs(); n++) {
+		operands.push_back(ctx.value(node->input(n)->origin()));
+		if (operands.back().is_top())
+			return lattice::top();
+	}
+
+	for (const auto & operand : operands) {
+		if (!operand.is_bits())
+			return lattice::bottom();
+	}
+
+	if (auto uop = dynamic_cast<const jive::bitunary_op*>(&op)) {
+		if (operands.size() == 1)
+			return lattice::bits(uop->reduce_constant(operands[0].bits()));
+	}
+
+	if (auto bop = dynamic_cast<const jive::bitbinary_op*>(&op)) {
+		if (operands.size() == 2)
+			return lattice::bits(bop->reduce_constants(operands[0].bits(), operands[1].bits()));
+	}
+
+	if (auto cop = dynamic_cast<const jive::bitcompare_op*>(&op)) {
+		if (operands.size() != 2)
+			return lattice::bottom();
+
+		switch (cop->reduce_constants(operands[0].bits(), operands[1].bits())) {
+			case jive::compare_result::static_true:
+				return lattice::bits(jive::bitvalue_repr(1, 1));
+			case jive::compare_result::static_false:
+				return lattice::bits(jive::bitvalue_repr(1, 0));
+			default:
+				return lattice::bottom();
+		}
+	}
+
+	if (auto mop = dynamic_cast<const jive::match_op*>(&op)) {
+		auto alternative = mop->alternative(operands[0].bits().to_uint());
+		return lattice::control(alternative, mop->nalternatives());
+	}
+
+	return lattice::bottom();
+}
+
+static void
+evaluate(const jive::region * region, sccpctx & ctx);
+
+static void
+evaluate_gamma(const jive::gamma_node * gamma, sccpctx & ctx)
+{
+	auto predicate = ctx.value(gamma->predicate()->origin());
+
+	for (auto ev = gamma->begin_entryvar(); ev != gamma->end_entryvar(); ev++) {
+		for (size_t n = 0; n < ev->narguments(); n++)
+			ctx.set(ev->argument(n), ctx.value(ev->origin()));
+	}
+
+	std::vector<lattice> outputs(gamma->noutputs(), lattice::top());
+	for (size_t r = 0; r < gamma->nsubregions(); r++) {
+		if (predicate.is_top() || (predicate.is_control() && predicate.alternative() != r))
+			continue;
+
+		auto subregion = gamma->subregion(r);
+		evaluate(subregion, ctx);
+		for (size_t n = 0; n < gamma->noutputs(); n++)
+			outputs[n] = outputs[n].meet(ctx.value(subregion->result(n)->origin()));
+	}
+
+	for (size_t n = 0; n < gamma->noutputs(); n++)
+		ctx.set(gamma->output(n), outputs[n]);
+}
+
+static void
+evaluate_theta(const jive::theta_node * theta, sccpctx & ctx)
+{
+	for (const auto & lv : *theta)
+		ctx.set(lv->argument(), ctx.value(lv->input()->origin()));
+
+	bool changed = true;
+	while (changed) {
+		evaluate(theta->subregion(), ctx);
+
+		/* the back edge is only taken if the predicate can select the repetition */
+		auto predicate = ctx.value(theta->predicate()->origin());
+		if (!predicate.is_bottom() && !(predicate.is_control() && predicate.alternative() == 1))
+			break;
+
+		changed = false;
+		for (const auto & lv : *theta) {
+			auto value = ctx.value(lv->argument()).meet(ctx.value(lv->result()->origin()));
+			if (value != ctx.value(lv->argument())) {
+				ctx.set(lv->argument(), value);
+				changed = true;
+			}
+		}
+	}
+
+	for (const auto & lv : *theta)
+		ctx.set(lv, ctx.value(lv->result()->origin()));
+}
+
+static void
+evaluate_structural(const jive::structural_node * node, sccpctx & ctx)
+{
+	if (auto gamma = dynamic_cast<const jive::gamma_node*>(node)) {
+		evaluate_gamma(gamma, ctx);
+		return;
+	}
+
+	if (auto theta = dynamic_cast<const jive::theta_node*>(node)) {
+		evaluate_theta(theta, ctx);
+		return;
+	}
+
+	/* lambda, phi, and delta nodes */
+	for (size_t r = 0; r < node->nsubregions(); r++) {
+		auto subregion = node->subregion(r);
+		for (size_t n = 0; n < subregion->narguments(); n++) {
+			auto argument = subregion->argument(n);
+			auto input = argument->input();
+			ctx.set(argument, input ? ctx.value(input->origin()) : lattice::bottom());
+		}
+
+		evaluate(subregion, ctx);
+	}
+
+	for (size_t n = 0; n < node->noutputs(); n++)
+		ctx.set(node->output(n), lattice::bottom());
+}
+
+static void
+evaluate(const jive::region * region, sccpctx & ctx)
+{
+	for (const auto & node : jive::topdown_traverser(const_cast<jive::region*>(region))) {
+		if (auto structnode = dynamic_cast<const jive::structural_node*>(node)) {
+			evaluate_structural(structnode, ctx);
+			continue;
+		}
+
+		auto value = node->noutputs() == 1 ? evaluate_simple(node, ctx) : lattice::bottom();
+		for (size_t n = 0; n < node->noutputs(); n++)
+			ctx.set(node->output(n), value);
+	}
+}
+
+/* transformation */
+
+static bool
+is_constant(const jive::node * node)
+{
+	return jive::is<jive::bitconstant_op>(node) || jive::is<jive::ctlconstant_op>(node);
+}
+
+static void
+replace_constants(jive::region * region, const sccpctx & ctx)
+{
+	std::vector<jive::output*> outputs;
+	for (size_t n = 0; n < region->narguments(); n++)
+		outputs.push_back(region->argument(n));
+
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				replace_constants(structnode->subregion(n), ctx);
+		}
+
+		if (is_constant(&node))
+			continue;
+
+		for (size_t n = 0; n < node.noutputs(); n++)
+			outputs.push_back(node.output(n));
+	}
+
+	for (const auto & output : outputs) {
+		if (output->nusers() == 0)
+			continue;
+
+		auto value = ctx.value(output);
+		if (value.is_bits()) {
+			jive::bitconstant_op op(value.bits());
+			output->divert_users(jive::simple_node::create_normalized(region, op, {})[0]);
+		} else if (value.is_control()) {
+			output->divert_users(jive_control_constant(region, value.nalternatives(),
+				value.alternative()));
+		}
+	}
+}
+
+static size_t
+constant_alternative(const jive::output * predicate)
+{
+	JLM_DEBUG_ASSERT(jive::is<jive::ctlconstant_op>(predicate->node()));
+	auto op = static_cast<const jive::ctlconstant_op*>(&predicate->node()->operation());
+	return op->value().alternative();
+}
+
+static void
+inline_gamma(jive::gamma_node * gamma)
+{
+	auto r = constant_alternative(gamma->predicate()->origin());
+	auto subregion = gamma->subregion(r);
+
+	jive::substitution_map smap;
+	for (auto ev = gamma->begin_entryvar(); ev != gamma->end_entryvar(); ev++)
+		smap.insert(ev->argument(r), ev->origin());
+
+	subregion->copy(gamma->region(), smap, false, false);
+
+	for (size_t n = 0; n < gamma->noutputs(); n++)
+		gamma->output(n)->divert_users(smap.lookup(subregion->result(n)->origin()));
+	remove(gamma);
+}
+
+static void
+inline_theta(jive::theta_node * theta)
+{
+	jive::substitution_map smap;
+	for (const auto & lv : *theta)
+		smap.insert(lv->argument(), lv->input()->origin());
+
+	theta->subregion()->copy(theta->region(), smap, false, false);
+
+	for (const auto & lv : *theta)
+		lv->divert_users(smap.lookup(lv->result()->origin()));
+	remove(theta);
+}
+
+static void
+reduce_structural(jive::region * region)
+{
+	std::vector<jive::structural_node*> nodes;
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node))
+			nodes.push_back(structnode);
+	}
+
+	for (const auto & node : nodes) {
+		for (size_t n = 0; n < node->nsubregions(); n++)
+			reduce_structural(node->subregion(n));
+
+		if (auto gamma = dynamic_cast<jive::gamma_node*>(node)) {
+			if (jive::is<jive::ctlconstant_op>(gamma->predicate()->origin()->node()))
+				inline_gamma(gamma);
+			continue;
+		}
+
+		/* a loop that exits after the first iteration */
+		if (auto theta = dynamic_cast<jive::theta_node*>(node)) {
+			auto predicate = theta->predicate()->origin();
+			if (jive::is<jive::ctlconstant_op>(predicate->node()) && constant_alternative(predicate) == 0)
+				inline_theta(theta);
+		}
+	}
+}
+
+void
+sccp(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef SCCPTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	sccpctx ctx;
+	for (size_t n = 0; n < root->narguments(); n++)
+		ctx.set(root->argument(n), lattice::bottom());
+
+	evaluate(root, ctx);
+	replace_constants(root, ctx);
+	reduce_structural(root);
+
+	#ifdef SCCPTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "SCCPTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
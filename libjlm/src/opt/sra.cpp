@@ -0,0 +1,222 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators/alloca.hpp>
+#include <jlm/ir/operators/getelementptr.hpp>
+#include <jlm/ir/operators/load.hpp>
+#include <jlm/ir/operators/store.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/sra.hpp>
+
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/types/record.h>
+
+#ifdef SRATIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+static bool
+is_constant(const jive::output * output, size_t & value)
+{
+	if (!jive::is<jive::bitconstant_op>(output->node()))
+		return false;
+
+	auto op = static_cast<const jive::bitconstant_op*>(&output->node()->operation());
+	if (!op->value().is_defined())
+		return false;
+
+	value = op->value().to_uint();
+	return true;
+}
+
+static size_t
+nelements(const jive::type & type)
+{
+	if (auto at = dynamic_cast<const arraytype*>(&type))
+		return at->nelements();
+
+	if (auto st = dynamic_cast<const structtype*>(&type))
+		return st->declaration()->nelements();
+
+	return 0;
+}
+
+static const jive::valuetype &
+element_type(const jive::type & type, size_t index)
+{
+	if (auto at = dynamic_cast<const arraytype*>(&type))
+		return at->element_type();
+
+	auto st = static_cast<const structtype*>(&type);
+	return *static_cast<const jive::valuetype*>(&st->declaration()->element(index));
+}
+
+/*
+	Checks that the address of an element is only used to load from or store to it, possibly
+	through getelementptr operations that stay within the element. Anything else might reach
+	beyond the element.
+*/
+static bool
+is_contained(const jive::output * address)
+{
+	for (const auto & user : *address) {
+		auto node = user->node();
+		if ((is<load_op>(node) || is<store_op>(node)) && user->index() == 0)
+			continue;
+
+		size_t first;
+		if (is<getelementptr_op>(node) && user->index() == 0 && node->ninputs() > 1
+		&& is_constant(node->input(1)->origin(), first) && first == 0
+		&& is_contained(node->output(0)))
+			continue;
+
+		return false;
+	}
+
+	return true;
+}
+
+/*
+	Checks that the alloca is only used as base of getelementptr operations that select
+	an element with a constant index, and that the addresses of the elements are only used
+	to access the elements.
+*/
+static bool
+is_splittable(const jive::node * alloca)
+{
+	auto op = static_cast<const alloca_op*>(&alloca->operation());
+	auto n = nelements(op->value_type());
+
+	size_t size;
+	if (n == 0 || !is_constant(alloca->input(0)->origin(), size) || size != 1)
+		return false;
+
+	for (const auto & user : *alloca->output(0)) {
+		auto node = user->node();
+		if (!is<getelementptr_op>(node) || user->index() != 0)
+			return false;
+
+		size_t first, index;
+		auto gop = static_cast<const getelementptr_op*>(&node->operation());
+		if (gop->nindices() < 2
+		|| !is_constant(node->input(1)->origin(), first) || first != 0
+		|| !is_constant(node->input(2)->origin(), index) || index >= n
+		|| !is_contained(node->output(0)))
+			return false;
+	}
+
+	return true;
+}
+
+static void
+split(jive::node * alloca, std::vector<jive::node*> & allocas)
+{
+	auto op = static_cast<const alloca_op*>(&alloca->operation());
+	auto & type = op->value_type();
+	auto size = alloca->input(0)->origin();
+
+	auto state = alloca->input(1)->origin();
+	std::unordered_map<size_t, jive::output*> elements;
+	auto element = [&](size_t index)
+	{
+		if (elements.find(index) != elements.end())
+			return elements[index];
+
+		auto outputs = create_alloca(element_type(type, index), size, state, op->alignment());
+		allocas.push_back(outputs[0]->node());
+		elements[index] = outputs[0];
+		state = outputs[1];
+		return outputs[0];
+	};
+
+	std::vector<jive::node*> geps;
+	for (const auto & user : *alloca->output(0))
+		geps.push_back(user->node());
+
+	for (const auto & gep : geps) {
+		size_t index;
+		is_constant(gep->input(2)->origin(), index);
+		auto address = element(index);
+
+		if (gep->ninputs() > 3) {
+			/* gep(a, 0, i, j, ...) becomes gep(a.i, 0, j, ...) */
+			std::vector<jive::bittype> btypes;
+			std::vector<jive::output*> operands({address, gep->input(1)->origin()});
+			for (size_t n = 3; n < gep->ninputs(); n++)
+				operands.push_back(gep->input(n)->origin());
+			for (size_t n = 1; n < operands.size(); n++)
+				btypes.push_back(*static_cast<const jive::bittype*>(&operands[n]->type()));
+
+			auto & rtype = *static_cast<const ptrtype*>(&gep->output(0)->type());
+			getelementptr_op gop(ptrtype(element_type(type, index)), btypes, rtype);
+			address = jive::simple_node::create_normalized(gep->region(), gop, operands)[0];
+		}
+
+		gep->output(0)->divert_users(address);
+		remove(gep);
+	}
+
+	alloca->output(1)->divert_users(state);
+	remove(alloca);
+}
+
+static void
+collect_allocas(jive::region * region, std::vector<jive::node*> & allocas)
+{
+	for (auto & node : region->nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				collect_allocas(structnode->subregion(n), allocas);
+			continue;
+		}
+
+		if (is<alloca_op>(&node))
+			allocas.push_back(&node);
+	}
+}
+
+static void
+sra(jive::region * region)
+{
+	std::vector<jive::node*> allocas;
+	collect_allocas(region, allocas);
+
+	/* allocas of nested aggregates are split again */
+	while (!allocas.empty()) {
+		auto alloca = allocas.back();
+		allocas.pop_back();
+
+		if (is_splittable(alloca))
+			split(alloca, allocas);
+	}
+}
+
+void
+sra(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef SRATIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	sra(root);
+
+	#ifdef SRATIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "SRATIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
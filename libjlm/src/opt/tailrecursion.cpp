@@ -0,0 +1,268 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/opt/tailrecursion.hpp>
+
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/phi.h>
+#include <jive/rvsdg/substitution.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+
+#ifdef TRETIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+static bool
+is_self_reference(const lambda_node * lambda, const jive::output * output)
+{
+	auto argument = dynamic_cast<const jive::argument*>(output);
+	if (!argument || argument->region() != lambda->subregion() || !argument->input())
+		return false;
+
+	auto recvar = dynamic_cast<const jive::argument*>(argument->input()->origin());
+	if (!recvar || recvar->input())
+		return false;
+
+	auto phi = recvar->region()->node();
+	if (!phi || !dynamic_cast<const jive::phi_op*>(&phi->operation()))
+		return false;
+
+	return recvar->region()->result(recvar->index())->origin() == lambda->output(0);
+}
+
+static bool
+has_initial_value(
+	const jive::type & type,
+	const std::vector<jive::argument*> & arguments)
+{
+	if (dynamic_cast<const jive::valuetype*>(&type))
+		return true;
+
+	for (const auto & argument : arguments) {
+		if (argument->type() == type)
+			return true;
+	}
+
+	return false;
+}
+
+static jive::output *
+create_initial_value(
+	const jive::type & type,
+	const std::vector<jive::argument*> & arguments)
+{
+	JLM_DEBUG_ASSERT(!arguments.empty());
+
+	if (dynamic_cast<const jive::valuetype*>(&type))
+		return undef_constant_op::create(arguments[0]->region(), type);
+
+	/* states are taken from the lambda's arguments, e.g., the memory and loop state */
+	for (const auto & argument : arguments) {
+		if (argument->type() == type)
+			return argument;
+	}
+
+	return nullptr;
+}
+
+static jive::simple_node *
+find_tail_call(const lambda_node * lambda, size_t r)
+{
+	auto subregion = lambda->subregion();
+	auto gamma = static_cast<jive::gamma_node*>(subregion->result(0)->origin()->node());
+
+	jive::simple_node * call = nullptr;
+	for (size_t n = 0; n < subregion->nresults(); n++) {
+		auto output = dynamic_cast<jive::structural_output*>(subregion->result(n)->origin());
+		if (!output || output->node() != gamma)
+			return nullptr;
+
+		auto origin = gamma->subregion(r)->result(output->index())->origin();
+		if (!is<call_op>(origin->node()) || origin->index() != n || origin->nusers() != 1)
+			return nullptr;
+
+		if (call && origin->node() != call)
+			return nullptr;
+
+		call = static_cast<jive::simple_node*>(origin->node());
+	}
+
+	if (call->noutputs() != subregion->nresults())
+		return nullptr;
+
+	auto function = dynamic_cast<const jive::argument*>(call->input(0)->origin());
+	if (!function || !is_self_reference(lambda, function->input()->origin()))
+		return nullptr;
+
+	return call;
+}
+
+static jive::simple_node *
+find_tail_call(const lambda_node * lambda, size_t * alternative)
+{
+	auto subregion = lambda->subregion();
+	if (subregion->nresults() == 0)
+		return nullptr;
+
+	auto gamma = dynamic_cast<jive::gamma_node*>(subregion->result(0)->origin()->node());
+	if (!gamma)
+		return nullptr;
+
+	auto arguments = lambda->arguments();
+	for (size_t n = 0; n < subregion->nresults(); n++) {
+		if (!has_initial_value(subregion->result(n)->type(), arguments))
+			return nullptr;
+	}
+
+	for (size_t r = 0; r < gamma->nsubregions(); r++) {
+		if (auto call = find_tail_call(lambda, r)) {
+			*alternative = r;
+			return call;
+		}
+	}
+
+	return nullptr;
+}
+
+static std::vector<std::vector<jive::node*>>
+collect_nodes(jive::region * region)
+{
+	std::vector<std::vector<jive::node*>> nodes;
+	for (auto & node : region->nodes) {
+		if (node.depth() >= nodes.size())
+			nodes.resize(node.depth()+1);
+		nodes[node.depth()].push_back(&node);
+	}
+
+	return nodes;
+}
+
+static void
+convert_tail_call(lambda_node * lambda, const jive::simple_node * call, size_t alternative)
+{
+	auto subregion = lambda->subregion();
+	auto ogamma = static_cast<jive::gamma_node*>(call->region()->node());
+
+	auto onodes = collect_nodes(subregion);
+	auto arguments = lambda->arguments();
+	std::vector<jive::output*> initvalues;
+	for (size_t n = 0; n < subregion->nresults(); n++)
+		initvalues.push_back(create_initial_value(subregion->result(n)->type(), arguments));
+
+	/* create loop variables for arguments, dependencies, and results */
+	auto theta = jive::theta_node::create(subregion);
+
+	jive::substitution_map smap;
+	std::vector<jive::theta_output*> arglvs;
+	for (size_t n = 0; n < subregion->narguments(); n++) {
+		auto argument = subregion->argument(n);
+		auto lv = theta->add_loopvar(argument);
+		smap.insert(argument, lv->argument());
+		if (argument->input() == nullptr)
+			arglvs.push_back(lv);
+	}
+
+	std::vector<jive::theta_output*> reslvs;
+	for (const auto & initvalue : initvalues)
+		reslvs.push_back(theta->add_loopvar(initvalue));
+
+	/* copy body into theta */
+	for (const auto & nodes : onodes) {
+		for (const auto & node : nodes)
+			node->copy(theta->subregion(), smap);
+	}
+
+	auto gamma = static_cast<jive::gamma_node*>(smap.lookup(ogamma->output(0))->node());
+	auto output = static_cast<jive::structural_output*>(subregion->result(0)->origin());
+	auto ncall = gamma->subregion(alternative)->result(output->index())->origin()->node();
+	JLM_DEBUG_ASSERT(is<call_op>(ncall));
+
+	/* the operands of the call become the arguments of the next iteration */
+	JLM_DEBUG_ASSERT(ncall->ninputs() == arglvs.size()+1);
+	for (size_t n = 0; n < arglvs.size(); n++) {
+		auto ev = gamma->add_entryvar(arglvs[n]->argument());
+
+		std::vector<jive::output*> values;
+		for (size_t r = 0; r < gamma->nsubregions(); r++)
+			values.push_back(r == alternative ? ncall->input(n+1)->origin() : ev->argument(r));
+		arglvs[n]->result()->divert_to(gamma->add_exitvar(values));
+	}
+
+	/* the results of the recursive alternative are never returned */
+	for (size_t n = 0; n < subregion->nresults(); n++) {
+		auto output = static_cast<jive::structural_output*>(subregion->result(n)->origin());
+		auto ev = gamma->add_entryvar(reslvs[n]->argument());
+		gamma->subregion(alternative)->result(output->index())->divert_to(ev->argument(alternative));
+		reslvs[n]->result()->divert_to(gamma->output(output->index()));
+	}
+
+	/* iterate as long as the recursive alternative is taken */
+	std::vector<jive::output*> predicates;
+	for (size_t r = 0; r < gamma->nsubregions(); r++) {
+		auto region = gamma->subregion(r);
+		predicates.push_back(jive_control_constant(region, 2, r == alternative ? 1 : 0));
+	}
+	theta->set_predicate(gamma->add_exitvar(predicates));
+	remove(ncall);
+
+	/* redirect results and remove original body */
+	for (size_t n = 0; n < subregion->nresults(); n++)
+		subregion->result(n)->divert_to(reslvs[n]);
+
+	for (auto it = onodes.rbegin(); it != onodes.rend(); it++) {
+		for (const auto & node : *it)
+			remove(node);
+	}
+}
+
+static void
+eliminate_tail_recursion(jive::region * region)
+{
+	for (auto & node : jive::topdown_traverser(region)) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				eliminate_tail_recursion(structnode->subregion(n));
+		}
+
+		auto lambda = dynamic_cast<lambda_node*>(node);
+		if (!lambda || !region->node()
+		|| !dynamic_cast<const jive::phi_op*>(&region->node()->operation()))
+			continue;
+
+		size_t alternative;
+		if (auto call = find_tail_call(lambda, &alternative))
+			convert_tail_call(lambda, call, alternative);
+	}
+}
+
+void
+eliminate_tail_recursion(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef TRETIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	eliminate_tail_recursion(root);
+
+	#ifdef TRETIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "TRETIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
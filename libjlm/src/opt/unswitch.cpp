@@ -0,0 +1,146 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/opt/unswitch.hpp>
+
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/substitution.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+
+#ifdef USWTIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+static jive::gamma_node *
+find_unswitchable_gamma(const jive::theta_node * theta)
+{
+	for (auto & node : theta->subregion()->nodes) {
+		auto gamma = dynamic_cast<jive::gamma_node*>(&node);
+		if (!gamma || gamma->noutputs() == 0)
+			continue;
+
+		auto argument = dynamic_cast<const jive::argument*>(gamma->predicate()->origin());
+		if (argument && jive::is_invariant(theta->output(argument->index())))
+			return gamma;
+	}
+
+	return nullptr;
+}
+
+static void
+inline_alternative(jive::gamma_node * gamma, size_t r)
+{
+	auto subregion = gamma->subregion(r);
+
+	jive::substitution_map smap;
+	for (auto ev = gamma->begin_entryvar(); ev != gamma->end_entryvar(); ev++)
+		smap.insert(ev->argument(r), ev->origin());
+
+	subregion->copy(gamma->region(), smap, false, false);
+
+	for (size_t n = 0; n < gamma->noutputs(); n++)
+		gamma->output(n)->divert_users(smap.lookup(subregion->result(n)->origin()));
+	remove(gamma);
+}
+
+bool
+unswitch(jive::theta_node * otheta, size_t budget)
+{
+	auto ogamma = find_unswitchable_gamma(otheta);
+	if (!ogamma) return false;
+
+	if (jive::nnodes(otheta->subregion()) * ogamma->nsubregions() > budget)
+		return false;
+
+	auto predicate = static_cast<const jive::argument*>(ogamma->predicate()->origin());
+	auto ngamma = jive::gamma_node::create(predicate->input()->origin(), ogamma->nsubregions());
+
+	std::vector<jive::gamma_input*> evs;
+	for (const auto & olv : *otheta)
+		evs.push_back(ngamma->add_entryvar(olv->input()->origin()));
+
+	std::vector<jive::theta_node*> nthetas;
+	std::vector<std::vector<jive::output*>> xvs(otheta->noutputs());
+	for (size_t r = 0; r < ngamma->nsubregions(); r++) {
+		auto ntheta = jive::theta_node::create(ngamma->subregion(r));
+
+		size_t n = 0;
+		jive::substitution_map smap;
+		std::vector<jive::theta_output*> nlvs;
+		for (const auto & olv : *otheta) {
+			auto nlv = ntheta->add_loopvar(evs[n++]->argument(r));
+			smap.insert(olv->argument(), nlv->argument());
+			nlvs.push_back(nlv);
+		}
+
+		otheta->subregion()->copy(ntheta->subregion(), smap, false, false);
+
+		n = 0;
+		for (const auto & olv : *otheta) {
+			nlvs[n]->result()->divert_to(smap.lookup(olv->result()->origin()));
+			xvs[n].push_back(nlvs[n]);
+			n++;
+		}
+		ntheta->set_predicate(smap.lookup(otheta->predicate()->origin()));
+
+		auto gamma = static_cast<jive::gamma_node*>(smap.lookup(ogamma->output(0))->node());
+		inline_alternative(gamma, r);
+
+		nthetas.push_back(ntheta);
+	}
+
+	size_t n = 0;
+	for (const auto & olv : *otheta)
+		olv->divert_users(ngamma->add_exitvar(xvs[n++]));
+	remove(otheta);
+
+	/* the copies might contain further unswitchable gamma nodes */
+	for (const auto & ntheta : nthetas)
+		unswitch(ntheta, budget);
+
+	return true;
+}
+
+static void
+unswitch(jive::region * region, size_t budget)
+{
+	for (auto & node : jive::topdown_traverser(region)) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				unswitch(structnode->subregion(n), budget);
+
+			if (auto theta = dynamic_cast<jive::theta_node*>(node))
+				unswitch(theta, budget);
+		}
+	}
+}
+
+void
+unswitch(jive::graph & rvsdg, size_t budget)
+{
+	auto root = rvsdg.root();
+
+	#ifdef USWTIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	unswitch(root, budget);
+
+	#ifdef USWTIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "USWTIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
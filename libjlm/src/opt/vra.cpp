@@ -0,0 +1,696 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <jlm/common.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/opt/vra.hpp>
+
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/theta.h>
+#include <jive/rvsdg/traverser.h>
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/comparison.h>
+#include <jive/types/bitstring/constant.h>
+
+#include <algorithm>
+#include <typeindex>
+
+#ifdef VRATIME
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace jlm {
+
+/*
+	Only bitstrings of up to 32 bits are tracked, such that the bounds of additions,
+	subtractions, and multiplications can be computed without overflow.
+*/
+static const size_t max_nbits = 32;
+
+/* number of theta iterations before the bounds of loop variables are widened */
+static const size_t nwiden = 3;
+
+/* number of theta iterations before the analysis gives up on a loop */
+static const size_t max_iterations = 16;
+
+/* interval */
+
+class interval final {
+public:
+	inline
+	interval(int64_t lo, int64_t hi)
+	: lo(lo)
+	, hi(hi)
+	{}
+
+	static inline interval
+	full(size_t nbits)
+	{
+		return interval(min(nbits), max(nbits));
+	}
+
+	static inline int64_t
+	min(size_t nbits)
+	{
+		return -(int64_t(1) << (nbits-1));
+	}
+
+	static inline int64_t
+	max(size_t nbits)
+	{
+		return (int64_t(1) << (nbits-1)) - 1;
+	}
+
+	inline bool
+	is_constant() const noexcept
+	{
+		return lo == hi;
+	}
+
+	inline bool
+	is_nonnegative() const noexcept
+	{
+		return lo >= 0;
+	}
+
+	inline bool
+	contains(int64_t value) const noexcept
+	{
+		return lo <= value && value <= hi;
+	}
+
+	inline interval
+	join(const interval & other) const noexcept
+	{
+		return interval(std::min(lo, other.lo), std::max(hi, other.hi));
+	}
+
+	/* an empty intersection means the value is not reachable, any interval is correct */
+	inline interval
+	meet(const interval & other) const noexcept
+	{
+		auto l = std::max(lo, other.lo);
+		auto h = std::min(hi, other.hi);
+		return l <= h ? interval(l, h) : *this;
+	}
+
+	inline bool
+	operator==(const interval & other) const noexcept
+	{
+		return lo == other.lo && hi == other.hi;
+	}
+
+	inline bool
+	operator!=(const interval & other) const noexcept
+	{
+		return !(*this == other);
+	}
+
+	int64_t lo;
+	int64_t hi;
+};
+
+/* clamps an interval computed without overflow to the representable values */
+static inline interval
+fit(int64_t lo, int64_t hi, size_t nbits)
+{
+	if (lo < interval::min(nbits) || hi > interval::max(nbits))
+		return interval::full(nbits);
+
+	return interval(lo, hi);
+}
+
+/* value as signed integer of the given width */
+static inline int64_t
+to_signed(uint64_t value, size_t nbits)
+{
+	if (value >= (uint64_t(1) << (nbits-1)))
+		return int64_t(value) - (int64_t(1) << nbits);
+
+	return value;
+}
+
+static inline size_t
+nbits(const jive::output * output)
+{
+	auto type = dynamic_cast<const jive::bittype*>(&output->type());
+	return type ? type->nbits() : 0;
+}
+
+static inline bool
+is_tracked(const jive::output * output)
+{
+	auto n = nbits(output);
+	return n != 0 && n <= max_nbits;
+}
+
+/* comparisons */
+
+enum class cmpkind {eq, ne, slt, sle, sgt, sge, ult, ule, ugt, uge};
+
+static bool
+compare_kind(const jive::operation & op, cmpkind & kind)
+{
+	static std::unordered_map<std::type_index, cmpkind> map({
+	  {typeid(jive::biteq_op), cmpkind::eq}, {typeid(jive::bitne_op), cmpkind::ne}
+	, {typeid(jive::bitslt_op), cmpkind::slt}, {typeid(jive::bitsle_op), cmpkind::sle}
+	, {typeid(jive::bitsgt_op), cmpkind::sgt}, {typeid(jive::bitsge_op), cmpkind::sge}
+	, {typeid(jive::bitult_op), cmpkind::ult}, {typeid(jive::bitule_op), cmpkind::ule}
+	, {typeid(jive::bitugt_op), cmpkind::ugt}, {typeid(jive::bituge_op), cmpkind::uge}
+	});
+
+	auto it = map.find(std::type_index(typeid(op)));
+	if (it == map.end())
+		return false;
+
+	kind = it->second;
+	return true;
+}
+
+static cmpkind
+negate(const cmpkind & kind)
+{
+	static std::unordered_map<cmpkind, cmpkind> map({
+	  {cmpkind::eq, cmpkind::ne}, {cmpkind::ne, cmpkind::eq}
+	, {cmpkind::slt, cmpkind::sge}, {cmpkind::sle, cmpkind::sgt}
+	, {cmpkind::sgt, cmpkind::sle}, {cmpkind::sge, cmpkind::slt}
+	, {cmpkind::ult, cmpkind::uge}, {cmpkind::ule, cmpkind::ugt}
+	, {cmpkind::ugt, cmpkind::ule}, {cmpkind::uge, cmpkind::ult}
+	});
+
+	return map[kind];
+}
+
+/* the comparison with swapped operands */
+static cmpkind
+swap(const cmpkind & kind)
+{
+	static std::unordered_map<cmpkind, cmpkind> map({
+	  {cmpkind::eq, cmpkind::eq}, {cmpkind::ne, cmpkind::ne}
+	, {cmpkind::slt, cmpkind::sgt}, {cmpkind::sle, cmpkind::sge}
+	, {cmpkind::sgt, cmpkind::slt}, {cmpkind::sge, cmpkind::sle}
+	, {cmpkind::ult, cmpkind::ugt}, {cmpkind::ule, cmpkind::uge}
+	, {cmpkind::ugt, cmpkind::ult}, {cmpkind::uge, cmpkind::ule}
+	});
+
+	return map[kind];
+}
+
+static inline bool
+is_unsigned(const cmpkind & kind)
+{
+	return kind == cmpkind::ult || kind == cmpkind::ule
+	    || kind == cmpkind::ugt || kind == cmpkind::uge;
+}
+
+/*
+	Returns 1 if the comparison always holds, 0 if it never holds, and -1 otherwise.
+	Unsigned comparisons are only decided for non-negative intervals, where they agree
+	with the signed comparisons.
+*/
+static int
+decide(const cmpkind & kind, const interval & a, const interval & b)
+{
+	if (is_unsigned(kind) && (!a.is_nonnegative() || !b.is_nonnegative()))
+		return -1;
+
+	switch (kind) {
+		case cmpkind::eq:
+			if (a.is_constant() && b.is_constant() && a.lo == b.lo) return 1;
+			if (a.hi < b.lo || b.hi < a.lo) return 0;
+			return -1;
+		case cmpkind::ne:
+			return decide(cmpkind::eq, a, b) < 0 ? -1 : 1 - decide(cmpkind::eq, a, b);
+		case cmpkind::slt: case cmpkind::ult:
+			if (a.hi < b.lo) return 1;
+			if (a.lo >= b.hi) return 0;
+			return -1;
+		case cmpkind::sle: case cmpkind::ule:
+			if (a.hi <= b.lo) return 1;
+			if (a.lo > b.hi) return 0;
+			return -1;
+		case cmpkind::sgt: case cmpkind::ugt:
+			return decide(cmpkind::slt, b, a);
+		case cmpkind::sge: case cmpkind::uge:
+			return decide(cmpkind::sle, b, a);
+	}
+
+	JLM_ASSERT(0);
+}
+
+/*
+	Refines the interval \p a under the assumption that a <kind> b holds.
+*/
+static interval
+refine(const cmpkind & kind, const interval & a, const interval & b, size_t nbits)
+{
+	auto full = interval::full(nbits);
+	switch (kind) {
+		case cmpkind::eq:
+			return a.meet(b);
+		case cmpkind::ne:
+			if (b.is_constant() && a.lo == b.lo && a.lo < a.hi) return interval(a.lo+1, a.hi);
+			if (b.is_constant() && a.hi == b.lo && a.lo < a.hi) return interval(a.lo, a.hi-1);
+			return a;
+		case cmpkind::slt:
+			return b.hi > full.lo ? a.meet(interval(full.lo, b.hi-1)) : a;
+		case cmpkind::sle:
+			return a.meet(interval(full.lo, b.hi));
+		case cmpkind::sgt:
+			return b.lo < full.hi ? a.meet(interval(b.lo+1, full.hi)) : a;
+		case cmpkind::sge:
+			return a.meet(interval(b.lo, full.hi));
+		case cmpkind::ult:
+			return b.is_nonnegative() && b.hi > 0 ? a.meet(interval(0, b.hi-1)) : a;
+		case cmpkind::ule:
+			return b.is_nonnegative() ? a.meet(interval(0, b.hi)) : a;
+		case cmpkind::ugt:
+			return a.is_nonnegative() && b.is_nonnegative() ? refine(cmpkind::sgt, a, b, nbits) : a;
+		case cmpkind::uge:
+			return a.is_nonnegative() && b.is_nonnegative() ? refine(cmpkind::sge, a, b, nbits) : a;
+	}
+
+	JLM_ASSERT(0);
+}
+
+/* context */
+
+class vractx final {
+public:
+	inline interval
+	value(const jive::output * output) const
+	{
+		JLM_DEBUG_ASSERT(is_tracked(output));
+		auto it = intervals_.find(output);
+		return it != intervals_.end() ? it->second : interval::full(nbits(output));
+	}
+
+	inline void
+	set(const jive::output * output, const interval & i)
+	{
+		if (!is_tracked(output))
+			return;
+
+		auto it = intervals_.find(output);
+		if (it != intervals_.end())
+			it->second = i;
+		else
+			intervals_.insert({output, i});
+	}
+
+private:
+	std::unordered_map<const jive::output*, interval> intervals_;
+};
+
+/* analysis */
+
+static inline const jive::bitconstant_op *
+constant(const jive::output * output)
+{
+	auto node = output->node();
+	return node ? dynamic_cast<const jive::bitconstant_op*>(&node->operation()) : nullptr;
+}
+
+static interval
+evaluate_simple(const jive::node * node, const vractx & ctx)
+{
+	auto output = node->output(0);
+	auto n = nbits(output);
+	auto full = interval::full(n);
+	auto & op = node->operation();
+
+	if (auto c = dynamic_cast<const jive::bitconstant_op*>(&op)) {
+		if (!c->value().is_defined())
+			return full;
+
+		auto v = to_signed(c->value().to_uint(), n);
+		return interval(v, v);
+	}
+
+	std::vector<interval> operands;
+	for (size_t i = 0; i < node->ninputs(); i++) {
+		if (!is_tracked(node->input(i)->origin()))
+			return full;
+		operands.push_back(ctx.value(node->input(i)->origin()));
+	}
+
+	if (jive::is<jive::bitadd_op>(node))
+		return fit(operands[0].lo + operands[1].lo, operands[0].hi + operands[1].hi, n);
+
+	if (jive::is<jive::bitsub_op>(node))
+		return fit(operands[0].lo - operands[1].hi, operands[0].hi - operands[1].lo, n);
+
+	if (jive::is<jive::bitmul_op>(node)) {
+		auto & a = operands[0], & b = operands[1];
+		std::vector<int64_t> p({a.lo*b.lo, a.lo*b.hi, a.hi*b.lo, a.hi*b.hi});
+		return fit(*std::min_element(p.begin(), p.end()), *std::max_element(p.begin(), p.end()), n);
+	}
+
+	/* the result of a mask is at most the non-negative mask */
+	if (jive::is<jive::bitand_op>(node)) {
+		if (operands[0].is_nonnegative())
+			return interval(0, operands[1].is_nonnegative()
+				? std::min(operands[0].hi, operands[1].hi) : operands[0].hi);
+		if (operands[1].is_nonnegative())
+			return interval(0, operands[1].hi);
+		return full;
+	}
+
+	if (jive::is<jive::bitumod_op>(node)) {
+		auto & b = operands[1];
+		if (b.is_nonnegative() && b.lo > 0)
+			return operands[0].is_nonnegative()
+				? interval(0, std::min(operands[0].hi, b.hi-1)) : interval(0, b.hi-1);
+		return full;
+	}
+
+	if (jive::is<jive::bitshr_op>(node)) {
+		auto & b = operands[1];
+		if (b.is_constant() && b.lo > 0 && size_t(b.lo) < n)
+			return interval(0, (int64_t(1) << (n-b.lo)) - 1);
+		if (operands[0].is_nonnegative() && b.is_nonnegative())
+			return interval(0, operands[0].hi);
+		return full;
+	}
+
+	if (auto zop = dynamic_cast<const zext_op*>(&op)) {
+		if (operands[0].is_nonnegative())
+			return operands[0];
+		return fit(0, (int64_t(1) << zop->nsrcbits()) - 1, n);
+	}
+
+	if (is<sext_op>(node))
+		return operands[0];
+
+	if (is<trunc_op>(node))
+		return fit(operands[0].lo, operands[0].hi, n);
+
+	cmpkind kind;
+	if (compare_kind(op, kind)) {
+		auto r = decide(kind, operands[0], operands[1]);
+		return r < 0 ? full : interval(to_signed(r, n), to_signed(r, n));
+	}
+
+	return full;
+}
+
+/*
+	Describes the values of a comparison operand under which an alternative is taken.
+*/
+struct condition {
+	const jive::output * operand;
+	cmpkind kind;
+	const jive::output * other;
+};
+
+/*
+	Returns the condition that holds if the control value \p predicate selects
+	\p alternative. The predicate must be a match of a one-bit comparison, of which
+	exactly one outcome selects the alternative.
+*/
+static bool
+find_condition(const jive::output * predicate, size_t alternative, std::vector<condition> & cs)
+{
+	auto match = predicate->node();
+	if (!match || !jive::is<jive::match_op>(match))
+		return false;
+
+	auto mop = static_cast<const jive::match_op*>(&match->operation());
+	auto compare = match->input(0)->origin()->node();
+	cmpkind kind;
+	if (mop->nbits() != 1 || !compare || !compare_kind(compare->operation(), kind))
+		return false;
+
+	bool t = mop->alternative(1) == alternative;
+	bool f = mop->alternative(0) == alternative;
+	if (t == f)
+		return false;
+
+	kind = t ? kind : negate(kind);
+	auto op1 = compare->input(0)->origin();
+	auto op2 = compare->input(1)->origin();
+	cs.push_back({op1, kind, op2});
+	cs.push_back({op2, swap(kind), op1});
+	return true;
+}
+
+static interval
+refine(const jive::output * output, const interval & i, const std::vector<condition> & cs,
+	const vractx & ctx)
+{
+	auto r = i;
+	for (const auto & c : cs) {
+		if (c.operand == output && is_tracked(c.other))
+			r = refine(c.kind, r, ctx.value(c.other), nbits(output));
+	}
+
+	return r;
+}
+
+/*
+	Returns the interval of the values of a match operand that select \p alternative.
+*/
+static interval
+match_interval(const jive::match_op & op, size_t alternative, const interval & i)
+{
+	if (alternative == op.default_alternative())
+		return i;
+
+	bool found = false;
+	int64_t lo = 0, hi = 0;
+	for (const auto & pair : op) {
+		if (pair.second != alternative)
+			continue;
+
+		auto v = to_signed(pair.first, op.nbits());
+		lo = found ? std::min(lo, v) : v;
+		hi = found ? std::max(hi, v) : v;
+		found = true;
+	}
+
+	return found ? i.meet(interval(lo, hi)) : i;
+}
+
+static void
+evaluate(const jive::region * region, vractx & ctx);
+
+static void
+evaluate_gamma(const jive::gamma_node * gamma, vractx & ctx)
+{
+	auto predicate = gamma->predicate()->origin();
+	auto match = predicate->node() && jive::is<jive::match_op>(predicate->node())
+		? static_cast<const jive::match_op*>(&predicate->node()->operation()) : nullptr;
+
+	for (size_t r = 0; r < gamma->nsubregions(); r++) {
+		std::vector<condition> cs;
+		find_condition(predicate, r, cs);
+
+		for (auto ev = gamma->begin_entryvar(); ev != gamma->end_entryvar(); ev++) {
+			auto origin = ev->origin();
+			if (!is_tracked(origin))
+				continue;
+
+			auto i = refine(origin, ctx.value(origin), cs, ctx);
+			if (match && predicate->node()->input(0)->origin() == origin
+			&& match->nbits() <= max_nbits)
+				i = match_interval(*match, r, i);
+
+			ctx.set(ev->argument(r), i);
+		}
+
+		evaluate(gamma->subregion(r), ctx);
+	}
+
+	for (size_t n = 0; n < gamma->noutputs(); n++) {
+		auto output = gamma->output(n);
+		if (!is_tracked(output))
+			continue;
+
+		auto i = ctx.value(gamma->subregion(0)->result(n)->origin());
+		for (size_t r = 1; r < gamma->nsubregions(); r++)
+			i = i.join(ctx.value(gamma->subregion(r)->result(n)->origin()));
+		ctx.set(output, i);
+	}
+}
+
+static inline interval
+widen(const interval & old, const interval & i, size_t nbits)
+{
+	auto full = interval::full(nbits);
+	return interval(i.lo < old.lo ? full.lo : i.lo, i.hi > old.hi ? full.hi : i.hi);
+}
+
+static void
+evaluate_theta(const jive::theta_node * theta, vractx & ctx)
+{
+	/* the back edge is only taken if the predicate selects the repetition */
+	std::vector<condition> cs;
+	find_condition(theta->predicate()->origin(), 1, cs);
+
+	for (const auto & lv : *theta) {
+		if (is_tracked(lv->argument()))
+			ctx.set(lv->argument(), ctx.value(lv->input()->origin()));
+	}
+
+	bool converged = false;
+	for (size_t n = 0; n < max_iterations && !converged; n++) {
+		evaluate(theta->subregion(), ctx);
+
+		converged = true;
+		for (const auto & lv : *theta) {
+			auto argument = lv->argument();
+			if (!is_tracked(argument))
+				continue;
+
+			auto result = lv->result()->origin();
+			auto i = ctx.value(lv->input()->origin());
+			i = i.join(refine(result, ctx.value(result), cs, ctx));
+			if (n >= nwiden)
+				i = widen(ctx.value(argument), i, nbits(argument));
+
+			if (i != ctx.value(argument)) {
+				ctx.set(argument, i);
+				converged = false;
+			}
+		}
+	}
+
+	if (!converged) {
+		for (const auto & lv : *theta) {
+			if (is_tracked(lv->argument()))
+				ctx.set(lv->argument(), interval::full(nbits(lv->argument())));
+		}
+		evaluate(theta->subregion(), ctx);
+	}
+
+	for (const auto & lv : *theta) {
+		if (is_tracked(lv))
+			ctx.set(lv, ctx.value(lv->result()->origin()));
+	}
+}
+
+static void
+evaluate(const jive::region * region, vractx & ctx)
+{
+	for (const auto & node : jive::topdown_traverser(const_cast<jive::region*>(region))) {
+		if (auto gamma = dynamic_cast<const jive::gamma_node*>(node)) {
+			evaluate_gamma(gamma, ctx);
+			continue;
+		}
+
+		if (auto theta = dynamic_cast<const jive::theta_node*>(node)) {
+			evaluate_theta(theta, ctx);
+			continue;
+		}
+
+		/* lambda, phi, and delta nodes */
+		if (auto structnode = dynamic_cast<const jive::structural_node*>(node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				evaluate(structnode->subregion(n), ctx);
+			continue;
+		}
+
+		if (node->noutputs() == 1 && is_tracked(node->output(0)))
+			ctx.set(node->output(0), evaluate_simple(node, ctx));
+	}
+}
+
+/* transformation */
+
+static void
+fold_compare(jive::node * node, const cmpkind & kind, const vractx & ctx)
+{
+	auto op1 = node->input(0)->origin();
+	auto op2 = node->input(1)->origin();
+	if (!is_tracked(op1) || !is_tracked(op2))
+		return;
+
+	auto r = decide(kind, ctx.value(op1), ctx.value(op2));
+	if (r < 0)
+		return;
+
+	node->output(0)->divert_users(jive::create_bitconstant(node->region(), 1, r));
+}
+
+static void
+fold_match(jive::node * node, const vractx & ctx)
+{
+	auto operand = node->input(0)->origin();
+	if (!is_tracked(operand))
+		return;
+
+	auto op = static_cast<const jive::match_op*>(&node->operation());
+	auto i = ctx.value(operand);
+
+	/* only keep the mappings of possible values */
+	std::unordered_map<uint64_t, uint64_t> mapping;
+	for (const auto & pair : *op) {
+		if (i.contains(to_signed(pair.first, op->nbits())))
+			mapping[pair.first] = pair.second;
+	}
+
+	if (i.is_constant()) {
+		auto alternative = op->alternative(uint64_t(i.lo) & ((uint64_t(1) << op->nbits()) - 1));
+		node->output(0)->divert_users(jive_control_constant(node->region(), op->nalternatives(),
+			alternative));
+		return;
+	}
+
+	if (mapping.size() == size_t(std::distance(op->begin(), op->end())))
+		return;
+
+	jive::match_op nop(op->nbits(), mapping, op->default_alternative(), op->nalternatives());
+	auto output = jive::simple_node::create_normalized(node->region(), nop, {operand})[0];
+	node->output(0)->divert_users(output);
+}
+
+static void
+fold(jive::region * region, const vractx & ctx)
+{
+	std::vector<jive::node*> nodes;
+	for (auto & node : region->nodes)
+		nodes.push_back(&node);
+
+	for (const auto & node : nodes) {
+		if (auto structnode = dynamic_cast<jive::structural_node*>(node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++)
+				fold(structnode->subregion(n), ctx);
+			continue;
+		}
+
+		cmpkind kind;
+		if (compare_kind(node->operation(), kind))
+			fold_compare(node, kind, ctx);
+		else if (jive::is<jive::match_op>(node))
+			fold_match(node, ctx);
+	}
+}
+
+void
+vra(jive::graph & rvsdg)
+{
+	auto root = rvsdg.root();
+
+	#ifdef VRATIME
+		auto nnodes = jive::nnodes(root);
+		auto start = std::chrono::high_resolution_clock::now();
+	#endif
+
+	vractx ctx;
+	evaluate(root, ctx);
+	fold(root, ctx);
+
+	#ifdef VRATIME
+		auto end = std::chrono::high_resolution_clock::now();
+		std::cout << "VRATIME: "
+		          << nnodes
+		          << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()
+		          << "\n";
+	#endif
+}
+
+}
@@ -10,6 +10,7 @@
 #include <jive/rvsdg/traverser.h>
 
 #include <jlm/common.hpp>
+#include <jlm/ir/attributes.hpp>
 #include <jlm/ir/basic-block.hpp>
 #include <jlm/ir/cfg-structure.hpp>
 #include <jlm/ir/module.hpp>
@@ -384,6 +385,7 @@ convert_lambda_node(const jive::node & node, context & ctx)
 	auto & clg = module.ipgraph();
 
 	auto f = function_node::create(clg, lambda->name(), lambda->fcttype(), lambda->linkage());
+	f->set_attributes(ctx.attributes(lambda));
 	auto v = module.create_variable(f);
 
 	f->add_cfg(create_cfg(node, ctx));
@@ -412,6 +414,7 @@ convert_phi_node(const jive::node & node, context & ctx)
 
 		if (auto lambda = dynamic_cast<const lambda_node*>(node)) {
 			auto f = function_node::create(ipg, lambda->name(), lambda->fcttype(), lambda->linkage());
+			f->set_attributes(ctx.attributes(lambda));
 			ctx.insert(subregion->argument(n), module.create_variable(f));
 		} else {
 			JLM_DEBUG_ASSERT(is<delta_op>(node));
@@ -495,7 +498,7 @@ rvsdg2jlm(const jlm::rvsdg & rvsdg)
 	auto graph = rvsdg.graph();
 	auto & clg = m->ipgraph();
 
-	context ctx(*m);
+	context ctx(*m, infer_attributes(*graph));
 
 	/* Add all imports to context */
 	for (size_t n = 0; n < graph->root()->narguments(); n++) {
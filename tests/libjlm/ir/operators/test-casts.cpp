@@ -0,0 +1,119 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+#include <test-types.hpp>
+
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+
+#include <jlm/ir/operators/operators.hpp>
+#include <jlm/ir/operators/sext.hpp>
+
+static inline jive::output *
+create_unary(const jive::operation & op, jive::output * operand)
+{
+	return jive::simple_node::create_normalized(operand->region(), op, {operand})[0];
+}
+
+static void
+test_bits()
+{
+	using namespace jlm;
+
+	jive::bittype bt8(8);
+	jive::bittype bt16(16);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto x = graph.add_import({bt8, "x"});
+	auto y = graph.add_import({bt16, "y"});
+
+	auto z1 = create_trunc(16, create_zext(32, x));
+	auto z2 = create_trunc(16, create_sext(64, y));
+	auto z3 = create_sext(32, create_sext(16, x));
+	auto z4 = create_trunc(8, jive::create_bitconstant(graph.root(), 16, 0x1234));
+
+	auto ex1 = graph.add_export(z1, {z1->type(), "z1"});
+	auto ex2 = graph.add_export(z2, {z2->type(), "z2"});
+	auto ex3 = graph.add_export(z3, {z3->type(), "z3"});
+	auto ex4 = graph.add_export(z4, {z4->type(), "z4"});
+
+//	jive::view(graph.root(), stdout);
+
+	nf->set_mutable(true);
+	graph.normalize();
+	graph.prune();
+
+//	jive::view(graph.root(), stdout);
+
+	auto zext = ex1->origin()->node();
+	assert(jive::is<zext_op>(zext) && zext->input(0)->origin() == x);
+
+	assert(ex2->origin() == y);
+
+	auto sext = ex3->origin()->node();
+	assert(jive::is<sext_op>(sext) && sext->input(0)->origin() == x);
+
+	auto c = dynamic_cast<const jive::bitconstant_op*>(&ex4->origin()->node()->operation());
+	assert(c && c->value().to_uint() == 0x34);
+}
+
+static void
+test_pointers()
+{
+	using namespace jlm;
+
+	jlm::valuetype vt;
+	jlm::ptrtype pt(vt);
+	jlm::ptrtype ppt(pt);
+	jive::bittype bt32(32);
+	jive::bittype bt64(64);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto p = graph.add_import({pt, "p"});
+
+	auto b = create_unary(ptr2bits_op(pt, bt64), p);
+	auto q = create_unary(bits2ptr_op(bt64, pt), b);
+
+	/* the pointer might not fit into 32 bits */
+	auto b32 = create_unary(ptr2bits_op(pt, bt32), p);
+	auto q32 = create_unary(bits2ptr_op(bt32, pt), b32);
+
+	auto c = create_unary(bitcast_op(pt, ppt), p);
+	auto r = create_unary(bitcast_op(ppt, pt), c);
+
+	auto ex1 = graph.add_export(q, {q->type(), "q"});
+	auto ex2 = graph.add_export(r, {r->type(), "r"});
+	auto ex3 = graph.add_export(q32, {q32->type(), "q32"});
+
+//	jive::view(graph.root(), stdout);
+
+	nf->set_mutable(true);
+	graph.normalize();
+	graph.prune();
+
+//	jive::view(graph.root(), stdout);
+
+	assert(ex1->origin() == p);
+	assert(ex2->origin() == p);
+	assert(jive::is<bits2ptr_op>(ex3->origin()->node()));
+}
+
+static int
+test()
+{
+	test_bits();
+	test_pointers();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/operators/test-casts", test)
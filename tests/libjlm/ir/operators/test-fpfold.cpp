@@ -0,0 +1,181 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include <test-registry.hpp>
+
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+
+#include <jlm/ir/operators/operators.hpp>
+
+#include <cmath>
+
+static inline jive::output *
+create_fpconstant(jive::region * region, double value)
+{
+	jlm::fpconstant_op op(jlm::fpsize::dbl, llvm::APFloat(value));
+	return jive::simple_node::create_normalized(region, op, {})[0];
+}
+
+static inline jive::output *
+create_fpbin(jlm::fpop fpop, jive::output * op1, jive::output * op2)
+{
+	jlm::fpbin_op op(fpop, jlm::fpsize::dbl);
+	return jive::simple_node::create_normalized(op1->region(), op, {op1, op2})[0];
+}
+
+static inline jive::output *
+create_fpcmp(jlm::fpcmp cmp, jive::output * op1, jive::output * op2)
+{
+	jlm::fpcmp_op op(cmp, jlm::fpsize::dbl);
+	return jive::simple_node::create_normalized(op1->region(), op, {op1, op2})[0];
+}
+
+static inline bool
+is_fpconstant(const jive::output * output, double value)
+{
+	auto op = dynamic_cast<const jlm::fpconstant_op*>(&output->node()->operation());
+	return op && op->constant().convertToDouble() == value;
+}
+
+static inline bool
+is_bitconstant(const jive::output * output, size_t value)
+{
+	auto op = dynamic_cast<const jive::bitconstant_op*>(&output->node()->operation());
+	return op && op->value().to_uint() == value;
+}
+
+static void
+test_fold()
+{
+	using namespace jlm;
+
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto c1 = create_fpconstant(graph.root(), 1.5);
+	auto c2 = create_fpconstant(graph.root(), 2.0);
+	auto nan = create_fpconstant(graph.root(), std::nan(""));
+
+	auto add = create_fpbin(fpop::add, c1, c2);
+	auto olt = create_fpcmp(fpcmp::olt, c1, nan);
+	auto ult = create_fpcmp(fpcmp::ult, c1, nan);
+
+	sitofp_op sop(bt32, fptype(fpsize::dbl));
+	auto m3 = jive::create_bitconstant(graph.root(), 32, -3);
+	auto sitofp = jive::simple_node::create_normalized(graph.root(), sop, {m3})[0];
+
+	auto ex1 = graph.add_export(add, {add->type(), "add"});
+	auto ex2 = graph.add_export(olt, {olt->type(), "olt"});
+	auto ex3 = graph.add_export(ult, {ult->type(), "ult"});
+	auto ex4 = graph.add_export(sitofp, {sitofp->type(), "sitofp"});
+
+//	jive::view(graph.root(), stdout);
+
+	nf->set_mutable(true);
+	graph.normalize();
+	graph.prune();
+
+//	jive::view(graph.root(), stdout);
+
+	assert(is_fpconstant(ex1->origin(), 3.5));
+	assert(is_bitconstant(ex2->origin(), 0));
+	assert(is_bitconstant(ex3->origin(), 1));
+	assert(is_fpconstant(ex4->origin(), -3.0));
+}
+
+static void
+test_identities()
+{
+	using namespace jlm;
+
+	fptype dbl(fpsize::dbl);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto x = graph.add_import({dbl, "x"});
+	auto one = create_fpconstant(graph.root(), 1.0);
+	auto zero = create_fpconstant(graph.root(), 0.0);
+
+	auto mul = create_fpbin(fpop::mul, one, x);
+	auto sub = create_fpbin(fpop::sub, x, zero);
+	auto add = create_fpbin(fpop::add, x, zero);
+
+	auto ex1 = graph.add_export(mul, {mul->type(), "mul"});
+	auto ex2 = graph.add_export(sub, {sub->type(), "sub"});
+	auto ex3 = graph.add_export(add, {add->type(), "add"});
+
+//	jive::view(graph.root(), stdout);
+
+	nf->set_mutable(true);
+	graph.normalize();
+	graph.prune();
+
+//	jive::view(graph.root(), stdout);
+
+	assert(ex1->origin() == x);
+	assert(ex2->origin() == x);
+
+	/* -0.0 + 0.0 is 0.0, and therefore x + 0.0 is not x */
+	assert(jive::is<fpbin_op>(ex3->origin()->node()));
+}
+
+static void
+test_fp2int()
+{
+	using namespace jlm;
+
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto c = create_fpconstant(graph.root(), 7.9);
+	auto large = create_fpconstant(graph.root(), 1e20);
+	auto nan = create_fpconstant(graph.root(), std::nan(""));
+
+	fp2si_op sop(fpsize::dbl, bt32);
+	auto fp2si1 = jive::simple_node::create_normalized(graph.root(), sop, {c})[0];
+	auto fp2si2 = jive::simple_node::create_normalized(graph.root(), sop, {large})[0];
+
+	fp2ui_op uop(fpsize::dbl, bt32);
+	auto fp2ui = jive::simple_node::create_normalized(graph.root(), uop, {nan})[0];
+
+	auto ex1 = graph.add_export(fp2si1, {fp2si1->type(), "fp2si1"});
+	auto ex2 = graph.add_export(fp2si2, {fp2si2->type(), "fp2si2"});
+	auto ex3 = graph.add_export(fp2ui, {fp2ui->type(), "fp2ui"});
+
+//	jive::view(graph.root(), stdout);
+
+	nf->set_mutable(true);
+	graph.normalize();
+	graph.prune();
+
+//	jive::view(graph.root(), stdout);
+
+	assert(is_bitconstant(ex1->origin(), 7));
+
+	/* out of range conversions and NaNs are not folded */
+	assert(jive::is<fp2si_op>(ex2->origin()->node()));
+	assert(jive::is<fp2ui_op>(ex3->origin()->node()));
+}
+
+static int
+test()
+{
+	test_fold();
+	test_identities();
+	test_fp2int();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/operators/test-fpfold", test)
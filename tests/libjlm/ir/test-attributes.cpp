@@ -0,0 +1,65 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.h>
+#include <jive/rvsdg/graph.h>
+
+#include <jlm/ir/attributes.hpp>
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg.hpp>
+
+static int
+verify()
+{
+	using namespace jlm;
+
+	jlm::valuetype vt;
+	jive::fcttype ft({&vt}, {&vt});
+	jlm::ptrtype pt(ft);
+
+	jive::graph graph;
+	auto g = graph.add_import(impport(pt, "g", linkage::external_linkage));
+
+	/* f1 does not access memory */
+	jlm::lambda_builder lb;
+	auto arguments = lb.begin_lambda(graph.root(), {ft, "f1", linkage::external_linkage});
+	auto t = jlm::create_testop(lb.subregion(), {arguments[0]}, {&vt})[0];
+	auto f1 = lb.end_lambda({t});
+
+	/* f2 only calls f1 */
+	arguments = lb.begin_lambda(graph.root(), {ft, "f2", linkage::external_linkage});
+	auto d = lb.add_dependency(f1->output(0));
+	auto call = jlm::create_call(d, {arguments[0]})[0];
+	auto f2 = lb.end_lambda({call});
+
+	/* f3 calls an unknown function */
+	arguments = lb.begin_lambda(graph.root(), {ft, "f3", linkage::external_linkage});
+	d = lb.add_dependency(g);
+	call = jlm::create_call(d, {arguments[0]})[0];
+	auto f3 = lb.end_lambda({call});
+
+	graph.add_export(f2->output(0), {f2->output(0)->type(), "f2"});
+	graph.add_export(f3->output(0), {f3->output(0)->type(), "f3"});
+
+//	jive::view(graph.root(), stdout);
+	auto attributes = jlm::infer_attributes(graph);
+
+	for (const auto & lambda : {f1, f2}) {
+		auto & a = attributes[lambda];
+		assert(a.contains(fctattribute::readnone));
+		assert(a.contains(fctattribute::nounwind));
+		assert(a.contains(fctattribute::norecurse));
+	}
+
+	assert(attributes[f3].empty());
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/ir/test-attributes", verify)
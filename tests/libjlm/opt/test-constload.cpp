@@ -0,0 +1,110 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+
+#include <jlm/ir/operators/delta.hpp>
+#include <jlm/ir/operators/getelementptr.hpp>
+#include <jlm/ir/operators/load.hpp>
+#include <jlm/ir/operators/operators.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/constload.hpp>
+
+static inline jive::output *
+create_table(jive::region * region, bool constant)
+{
+	jive::bittype bt32(32);
+	jlm::arraytype at(bt32, 3);
+
+	jlm::delta_builder db;
+	auto r = db.begin(region, jlm::ptrtype(at), "table", jlm::linkage::internal_linkage, constant);
+
+	std::vector<jive::output*> elements;
+	for (size_t n = 0; n < 3; n++)
+		elements.push_back(jive::create_bitconstant(r, 32, n+1));
+
+	jlm::data_array_constant_op op(bt32, 3);
+	return db.end(jive::simple_node::create_normalized(r, op, elements)[0]);
+}
+
+static inline jive::output *
+create_gep(jive::output * address, size_t index)
+{
+	jive::bittype bt32(32);
+	auto & at = *static_cast<const jlm::arraytype*>(
+		&static_cast<const jlm::ptrtype*>(&address->type())->pointee_type());
+
+	auto zero = jive::create_bitconstant(address->region(), 32, 0);
+	auto idx = jive::create_bitconstant(address->region(), 32, index);
+	jlm::getelementptr_op op(*static_cast<const jlm::ptrtype*>(&address->type()), {bt32, bt32},
+		jlm::ptrtype(at.element_type()));
+	return jive::simple_node::create_normalized(address->region(), op, {address, zero, idx})[0];
+}
+
+static inline void
+test_constant()
+{
+	jive::memtype mt;
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto s = graph.add_import({mt, "s"});
+
+	auto table = create_table(graph.root(), true);
+	auto ld = jlm::create_load(create_gep(table, 1), {s}, 4);
+
+	auto ex1 = graph.add_export(ld[0], {bt32, "v"});
+	auto ex2 = graph.add_export(ld[1], {mt, "s"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::fold_constant_loads(graph);
+//	jive::view(graph.root(), stdout);
+
+	auto node = ex1->origin()->node();
+	assert(jive::is<jive::bitconstant_op>(node));
+	assert(static_cast<const jive::bitconstant_op*>(&node->operation())->value().to_uint() == 2);
+	assert(ex2->origin() == s);
+}
+
+static inline void
+test_mutable()
+{
+	jive::memtype mt;
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto s = graph.add_import({mt, "s"});
+
+	auto table = create_table(graph.root(), false);
+	auto ld = jlm::create_load(create_gep(table, 1), {s}, 4);
+
+	auto ex = graph.add_export(ld[0], {bt32, "v"});
+
+	jlm::fold_constant_loads(graph);
+
+	assert(ex->origin() == ld[0]);
+}
+
+static int
+verify()
+{
+	test_constant();
+	test_mutable();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-constload", verify)
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.h>
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/gamma.h>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/opt/devirtualization.hpp>
+
+static inline jlm::lambda_node *
+create_function(jive::region * region, const std::string & name)
+{
+	jlm::valuetype vt;
+	jive::fcttype ft({&vt}, {&vt});
+
+	jlm::lambda_builder lb;
+	auto arguments = lb.begin_lambda(region, {ft, name, jlm::linkage::external_linkage});
+	auto t = jlm::create_testop(lb.subregion(), {arguments[0]}, {&vt})[0];
+	return lb.end_lambda({t});
+}
+
+/*
+	Creates a function that calls either \p f1 or \p f2 depending on its first argument.
+*/
+static inline jive::node *
+create_caller(jive::region * region, jlm::lambda_node * f1, jlm::lambda_node * f2)
+{
+	jlm::valuetype vt;
+	jive::ctltype ct(2);
+	jive::fcttype ft({&ct, &vt}, {&vt});
+
+	jlm::lambda_builder lb;
+	auto arguments = lb.begin_lambda(region, {ft, "g", jlm::linkage::external_linkage});
+	auto d1 = lb.add_dependency(f1->output(0));
+	auto d2 = lb.add_dependency(f2->output(0));
+
+	auto gamma = jive::gamma_node::create(arguments[0], 2);
+	auto ev1 = gamma->add_entryvar(d1);
+	auto ev2 = gamma->add_entryvar(d2);
+	auto fct = gamma->add_exitvar({ev1->argument(0), ev2->argument(1)});
+
+	auto call = jlm::create_call(fct, {arguments[1]})[0];
+	lb.end_lambda({call});
+
+	return call->node();
+}
+
+static inline void
+test_direct()
+{
+	jive::graph graph;
+
+	auto f = create_function(graph.root(), "f");
+	auto call = create_caller(graph.root(), f, f);
+
+//	jive::view(graph.root(), stdout);
+	jlm::devirtualize(graph);
+//	jive::view(graph.root(), stdout);
+
+	auto argument = dynamic_cast<const jive::argument*>(call->input(0)->origin());
+	assert(argument && argument->input()->origin() == f->output(0));
+}
+
+static inline void
+test_dispatch()
+{
+	jive::graph graph;
+
+	auto f1 = create_function(graph.root(), "f1");
+	auto f2 = create_function(graph.root(), "f2");
+	auto call = create_caller(graph.root(), f1, f2);
+	auto region = call->region();
+
+//	jive::view(graph.root(), stdout);
+	jlm::devirtualize(graph);
+//	jive::view(graph.root(), stdout);
+
+	auto gamma = dynamic_cast<const jive::gamma_node*>(region->result(0)->origin()->node());
+	assert(gamma && gamma->nsubregions() == 2);
+	for (size_t n = 0; n < gamma->nsubregions(); n++) {
+		auto node = gamma->subregion(n)->result(0)->origin()->node();
+		assert(jive::is<jlm::call_op>(node));
+
+		auto argument = static_cast<const jive::argument*>(node->input(0)->origin());
+		auto dependency = static_cast<const jive::argument*>(argument->input()->origin());
+		assert(dependency->input()->origin() == (n == 0 ? f1 : f2)->output(0));
+	}
+}
+
+static int
+verify()
+{
+	test_direct();
+	test_dispatch();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-devirtualization", verify)
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/arch/addresstype.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+#include <jive/rvsdg/gamma.h>
+
+#include <jlm/ir/operators/alloca.hpp>
+#include <jlm/ir/operators/load.hpp>
+#include <jlm/ir/operators/store.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/dse.hpp>
+
+static inline void
+test_overwritten()
+{
+	jlm::valuetype vt;
+	jlm::ptrtype pt(vt);
+	jive::memtype mt;
+	jive::ctltype ct(2);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto c = graph.add_import({ct, "c"});
+	auto a = graph.add_import({pt, "a"});
+	auto v = graph.add_import({vt, "v"});
+	auto s = graph.add_import({mt, "s"});
+
+	auto s1 = jlm::create_store(a, v, {s}, 4);
+
+	auto gamma = jive::gamma_node::create(c, 2);
+	auto eva = gamma->add_entryvar(a);
+	auto evv = gamma->add_entryvar(v);
+	auto evs = gamma->add_entryvar(s1[0]);
+	auto s2 = jlm::create_store(eva->argument(0), evv->argument(0), {evs->argument(0)}, 4);
+	auto s3 = jlm::create_store(eva->argument(1), evv->argument(1), {evs->argument(1)}, 4);
+	auto xvs = gamma->add_exitvar({s2[0], s3[0]});
+
+	auto ex = graph.add_export(xvs, {mt, "s"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::dse(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(gamma->input(evs->index())->origin() == s);
+	assert(gamma->subregion(0)->nnodes() == 1);
+	assert(gamma->subregion(1)->nnodes() == 1);
+	assert(ex->origin() == xvs);
+}
+
+static inline void
+test_read()
+{
+	jlm::valuetype vt;
+	jlm::ptrtype pt(vt);
+	jive::memtype mt;
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto a = graph.add_import({pt, "a"});
+	auto b = graph.add_import({pt, "b"});
+	auto v = graph.add_import({vt, "v"});
+	auto s = graph.add_import({mt, "s"});
+
+	auto s1 = jlm::create_store(a, v, {s}, 4);
+	auto ld = jlm::create_load(b, s1, 4);
+	auto s2 = jlm::create_store(a, v, {ld[1]}, 4);
+
+	graph.add_export(ld[0], {vt, "v"});
+	graph.add_export(s2[0], {mt, "s"});
+
+	jlm::dse(graph);
+
+	assert(ld[0]->node()->input(1)->origin() == s1[0]);
+}
+
+static inline void
+test_local()
+{
+	jlm::valuetype vt;
+	jive::memtype mt;
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto v = graph.add_import({vt, "v"});
+	auto s = graph.add_import({mt, "s"});
+
+	auto size = jive::create_bitconstant(graph.root(), 32, 1);
+	auto alloca = jlm::create_alloca(vt, size, s, 4);
+	auto s1 = jlm::create_store(alloca[0], v, {alloca[1]}, 4);
+
+	auto ex = graph.add_export(s1[0], {mt, "s"});
+
+	jlm::dse(graph);
+
+	assert(ex->origin() == alloca[1]);
+}
+
+static int
+verify()
+{
+	test_overwritten();
+	test_read();
+	test_local();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-dse", verify)
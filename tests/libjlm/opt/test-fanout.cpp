@@ -0,0 +1,57 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/arch/addresstype.h>
+#include <jive/rvsdg/statemux.h>
+#include <jive/view.h>
+
+#include <jlm/ir/operators/load.hpp>
+#include <jlm/ir/operators/store.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/fanout.hpp>
+
+static int
+verify()
+{
+	jlm::valuetype vt;
+	jlm::ptrtype pt(vt);
+	jive::memtype mt;
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto a = graph.add_import({pt, "a"});
+	auto b = graph.add_import({pt, "b"});
+	auto s = graph.add_import({mt, "s"});
+
+	auto ld1 = jlm::create_load(a, {s}, 4);
+	auto ld2 = jlm::create_load(b, {ld1[1]}, 4);
+	auto ld3 = jlm::create_load(a, {ld2[1]}, 4);
+	auto st = jlm::create_store(b, ld3[0], {ld3[1]}, 4);
+
+	graph.add_export(ld1[0], {vt, "v1"});
+	graph.add_export(ld2[0], {vt, "v2"});
+	graph.add_export(st[0], {mt, "s"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::fanout_loads(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(ld1[0]->node()->input(1)->origin() == s);
+	assert(ld2[0]->node()->input(1)->origin() == s);
+	assert(ld3[0]->node()->input(1)->origin() == s);
+
+	auto mux = st[0]->node()->input(2)->origin()->node();
+	assert(jive::is<jive::mux_op>(mux) && mux->ninputs() == 3);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-fanout", verify)
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/theta.h>
+
+#include <jlm/ir/operators/load.hpp>
+#include <jlm/ir/operators/store.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/forwarding.hpp>
+
+static inline void
+test_gamma()
+{
+	jlm::valuetype vt;
+	jlm::ptrtype pt(vt);
+	jive::memtype mt;
+	jive::ctltype ct(2);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto c = graph.add_import({ct, "c"});
+	auto a = graph.add_import({pt, "a"});
+	auto v1 = graph.add_import({vt, "v1"});
+	auto v2 = graph.add_import({vt, "v2"});
+	auto s = graph.add_import({mt, "s"});
+
+	auto s1 = jlm::create_store(a, v1, {s}, 4);
+
+	auto gamma = jive::gamma_node::create(c, 2);
+	auto eva = gamma->add_entryvar(a);
+	auto evv = gamma->add_entryvar(v2);
+	auto evs = gamma->add_entryvar(s1[0]);
+	auto s2 = jlm::create_store(eva->argument(0), evv->argument(0), {evs->argument(0)}, 4);
+	auto xvs = gamma->add_exitvar({s2[0], evs->argument(1)});
+
+	auto ld = jlm::create_load(a, {xvs}, 4);
+
+	auto ex1 = graph.add_export(ld[0], {vt, "v"});
+	auto ex2 = graph.add_export(ld[1], {mt, "s"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::forward_stores(graph);
+//	jive::view(graph.root(), stdout);
+
+	auto output = ex1->origin();
+	assert(output->node() == gamma);
+	assert(gamma->subregion(0)->result(output->index())->origin() == evv->argument(0));
+	auto argument = dynamic_cast<jive::argument*>(gamma->subregion(1)->result(output->index())->origin());
+	assert(argument && argument->input()->origin() == v1);
+	assert(ex2->origin() == xvs);
+}
+
+static inline void
+test_theta()
+{
+	jlm::valuetype vt;
+	jlm::ptrtype pt(vt);
+	jive::memtype mt;
+	jive::ctltype ct(2);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto c = graph.add_import({ct, "c"});
+	auto a = graph.add_import({pt, "a"});
+	auto v = graph.add_import({vt, "v"});
+	auto s = graph.add_import({mt, "s"});
+
+	auto s1 = jlm::create_store(a, v, {s}, 4);
+
+	auto theta = jive::theta_node::create(graph.root());
+	auto lvc = theta->add_loopvar(c);
+	auto lva = theta->add_loopvar(a);
+	auto lvs = theta->add_loopvar(s1[0]);
+
+	auto ld = jlm::create_load(lva->argument(), {lvs->argument()}, 4);
+	auto u = jlm::create_testop(theta->subregion(), {ld[0]}, {&vt});
+	auto s2 = jlm::create_store(lva->argument(), u[0], {ld[1]}, 4);
+
+	lvs->result()->divert_to(s2[0]);
+	theta->set_predicate(lvc->argument());
+
+	graph.add_export(lvs, {mt, "s"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::forward_stores(graph);
+//	jive::view(graph.root(), stdout);
+
+	auto argument = dynamic_cast<jive::argument*>(u[0]->node()->input(0)->origin());
+	assert(argument && argument->input()->origin() == v);
+	assert(theta->subregion()->result(argument->index()+1)->origin() == u[0]);
+	assert(s2[0]->node()->input(2)->origin() == lvs->argument());
+}
+
+static int
+verify()
+{
+	test_gamma();
+	test_theta();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-forwarding", verify)
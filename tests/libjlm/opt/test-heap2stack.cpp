@@ -0,0 +1,131 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/arch/addresstype.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/gamma.h>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/ir/rvsdg.hpp>
+#include <jlm/opt/heap2stack.hpp>
+
+static inline void
+test(bool escape)
+{
+	using namespace jlm;
+
+	jive::memtype mt;
+	jlm::loopstatetype lt;
+	jive::bittype bt8(8);
+	jlm::ptrtype pt(bt8);
+	jive::fcttype mft({&jive::bit64, &mt, &lt}, {&pt, &mt, &lt});
+	jive::fcttype fft({&pt, &mt, &lt}, {&mt, &lt});
+	jive::fcttype ft({&mt, &lt}, {&pt, &mt, &lt});
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto fm = graph.add_import(impport(ptrtype(mft), "malloc", linkage::external_linkage));
+	auto ff = graph.add_import(impport(ptrtype(fft), "free", linkage::external_linkage));
+
+	jlm::lambda_builder lb;
+	auto arguments = lb.begin_lambda(graph.root(), {ft, "f", linkage::external_linkage});
+	auto m = lb.add_dependency(fm);
+	auto f = lb.add_dependency(ff);
+
+	auto size = jive::create_bitconstant(lb.subregion(), 64, 4);
+	auto c1 = create_call(m, {size, arguments[0], arguments[1]});
+	auto value = jive::create_bitconstant(lb.subregion(), 8, 42);
+	auto s = create_store(c1[0], value, {c1[1]}, 1);
+	auto ld = create_load(c1[0], s, 1);
+	auto c2 = create_call(f, {c1[0], ld[1], c1[2]});
+
+	auto r = escape ? c1[0] : create_testop(lb.subregion(), {ld[0]}, {&pt})[0];
+	auto lambda = lb.end_lambda({r, c2[0], c2[1]});
+
+	graph.add_export(lambda->output(0), {lambda->output(0)->type(), "f"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::heap2stack(graph);
+//	jive::view(graph.root(), stdout);
+
+	auto address = ld[0]->node()->input(0)->origin();
+	if (escape) {
+		assert(address == c1[0]);
+		return;
+	}
+
+	assert(is<alloca_op>(address->node()));
+	assert(address->node()->input(1)->origin() == arguments[0]);
+	assert(lb.subregion()->result(1)->origin() == ld[1]);
+	assert(lb.subregion()->result(2)->origin() == arguments[1]);
+}
+
+static inline void
+test_merged()
+{
+	using namespace jlm;
+
+	jive::memtype mt;
+	jlm::loopstatetype lt;
+	jive::ctltype ct(2);
+	jive::bittype bt8(8);
+	jlm::ptrtype pt(bt8);
+	jive::fcttype mft({&jive::bit64, &mt, &lt}, {&pt, &mt, &lt});
+	jive::fcttype fft({&pt, &mt, &lt}, {&mt, &lt});
+	jive::fcttype ft({&ct, &pt, &mt, &lt}, {&mt, &lt});
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto fm = graph.add_import(impport(ptrtype(mft), "malloc", linkage::external_linkage));
+	auto ff = graph.add_import(impport(ptrtype(fft), "free", linkage::external_linkage));
+
+	jlm::lambda_builder lb;
+	auto arguments = lb.begin_lambda(graph.root(), {ft, "f", linkage::external_linkage});
+	auto m = lb.add_dependency(fm);
+	auto f = lb.add_dependency(ff);
+
+	/* free(c ? malloc(4) : other) */
+	auto size = jive::create_bitconstant(lb.subregion(), 64, 4);
+	auto c1 = create_call(m, {size, arguments[2], arguments[3]});
+
+	auto gamma = jive::gamma_node::create(arguments[0], 2);
+	auto evp = gamma->add_entryvar(c1[0]);
+	auto evo = gamma->add_entryvar(arguments[1]);
+	auto q = gamma->add_exitvar({evp->argument(0), evo->argument(1)});
+
+	auto c2 = create_call(f, {q, c1[1], c1[2]});
+	auto lambda = lb.end_lambda({c2[0], c2[1]});
+
+	graph.add_export(lambda->output(0), {lambda->output(0)->type(), "f"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::heap2stack(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(evp->origin() == c1[0]);
+	assert(is<call_op>(lb.subregion()->result(0)->origin()->node()));
+}
+
+static int
+verify()
+{
+	test(false);
+	test(true);
+	test_merged();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-heap2stack", verify)
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/comparison.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/graph.h>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/opt/ifconversion.hpp>
+
+static inline void
+test_gamma()
+{
+	using namespace jive;
+
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto x = graph.add_import({bt32, "x"});
+	auto y = graph.add_import({bt32, "y"});
+
+	auto cmp = bitult_op::create(32, x, y);
+	auto predicate = jive::match(1, {{1, 1}}, 0, 2, cmp);
+
+	auto gamma = gamma_node::create(predicate, 2);
+	auto evx = gamma->add_entryvar(x);
+	auto evy = gamma->add_entryvar(y);
+	auto one = create_bitconstant(gamma->subregion(0), 32, 1);
+	auto add = bitadd_op::create(32, evx->argument(0), one);
+	auto ex = gamma->add_exitvar({add, evy->argument(1)});
+
+	auto e = graph.add_export(ex, {bt32, "z"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::ifconvert(graph);
+//	jive::view(graph.root(), stdout);
+
+	auto select = e->origin()->node();
+	assert(jive::is<jlm::select_op>(select));
+	assert(select->input(0)->origin() == cmp);
+	assert(select->input(1)->origin() == y);
+	assert(jive::is<bitadd_op>(select->input(2)->origin()->node()));
+}
+
+static inline void
+test_select()
+{
+	using namespace jive;
+
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto p = graph.add_import({jive::bit1, "p"});
+	auto x = graph.add_import({bt32, "x"});
+	auto y = graph.add_import({bt32, "y"});
+
+	auto t = x;
+	for (size_t n = 0; n < 8; n++)
+		t = bitmul_op::create(32, t, x);
+
+	jlm::select_op op(bt32);
+	auto select = simple_node::create_normalized(graph.root(), op, {p, t, y})[0];
+
+	auto e = graph.add_export(select, {bt32, "z"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::ifconvert(graph);
+//	jive::view(graph.root(), stdout);
+
+	auto gamma = dynamic_cast<jive::gamma_node*>(e->origin()->node());
+	assert(gamma);
+	assert(gamma->subregion(0)->nnodes() == 0);
+	assert(gamma->subregion(1)->nnodes() == 8);
+}
+
+static inline void
+test_argument_predicate()
+{
+	using namespace jive;
+
+	jive::bittype bt32(32);
+	jive::ctltype ct(2);
+	jive::fcttype ft({&ct, &bt32, &bt32}, {&bt32});
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	/* the predicate is a lambda argument and not produced by a match */
+	jlm::lambda_builder lb;
+	auto arguments = lb.begin_lambda(graph.root(), {ft, "f", jlm::linkage::external_linkage});
+
+	auto gamma = gamma_node::create(arguments[0], 2);
+	auto evx = gamma->add_entryvar(arguments[1]);
+	auto evy = gamma->add_entryvar(arguments[2]);
+	auto one = create_bitconstant(gamma->subregion(0), 32, 1);
+	auto add = bitadd_op::create(32, evx->argument(0), one);
+	auto ex = gamma->add_exitvar({add, evy->argument(1)});
+
+	auto lambda = lb.end_lambda({ex});
+	graph.add_export(lambda->output(0), {lambda->output(0)->type(), "f"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::ifconvert(graph);
+//	jive::view(graph.root(), stdout);
+
+	auto select = lambda->subregion()->result(0)->origin()->node();
+	assert(jive::is<jlm::select_op>(select));
+
+	auto p = select->input(0)->origin()->node();
+	assert(jive::is<jlm::ctl2bits_op>(p) && p->input(0)->origin() == arguments[0]);
+}
+
+static int
+verify()
+{
+	test_gamma();
+	test_select();
+	test_argument_predicate();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-ifconversion", verify)
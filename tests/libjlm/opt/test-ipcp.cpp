@@ -0,0 +1,75 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/opt/ipcp.hpp>
+
+static const jlm::lambda_node *
+callee(const jive::node * call)
+{
+	auto argument = static_cast<const jive::argument*>(call->input(0)->origin());
+	return static_cast<const jlm::lambda_node*>(argument->input()->origin()->node());
+}
+
+static int
+verify()
+{
+	using namespace jlm;
+
+	jive::bittype bt32(32);
+	jive::fcttype ft({&bt32, &bt32, &bt32}, {&bt32});
+	jive::fcttype gt({&bt32, &bt32, &bt32}, {&bt32, &bt32, &bt32});
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	/* f */
+	jlm::lambda_builder lb;
+	auto arguments = lb.begin_lambda(graph.root(), {ft, "f", linkage::internal_linkage});
+	auto t = create_testop(lb.subregion(), {arguments[0], arguments[1], arguments[2]}, {&bt32})[0];
+	auto f = lb.end_lambda({t});
+
+	/* g */
+	arguments = lb.begin_lambda(graph.root(), {gt, "g", linkage::external_linkage});
+	auto d = lb.add_dependency(f->output(0));
+	auto c3 = jive::create_bitconstant(lb.subregion(), 32, 3);
+	auto c7 = jive::create_bitconstant(lb.subregion(), 32, 7);
+	auto c9 = jive::create_bitconstant(lb.subregion(), 32, 9);
+	auto call1 = create_call(d, {arguments[0], c3, c7})[0];
+	auto call2 = create_call(d, {arguments[1], c3, c7})[0];
+	auto call3 = create_call(d, {arguments[2], c3, c9})[0];
+	auto g = lb.end_lambda({call1, call2, call3});
+
+	graph.add_export(g->output(0), {g->output(0)->type(), "g"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::ipcp(graph);
+//	jive::view(graph.root(), stdout);
+
+	/* the second argument is always three */
+	assert(f->subregion()->argument(1)->nusers() == 0);
+	assert(f->subregion()->argument(2)->nusers() == 1);
+
+	/* the first two calls use a specialization */
+	auto spec = callee(call1->node());
+	assert(spec != f && spec->name() == "f.spec0");
+	assert(callee(call2->node()) == spec);
+	assert(spec->subregion()->argument(1)->nusers() == 0);
+	assert(spec->subregion()->argument(2)->nusers() == 0);
+
+	assert(callee(call3->node()) == f);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-ipcp", verify)
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/comparison.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/simple-node.h>
+#include <jive/rvsdg/theta.h>
+
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/loopdeletion.hpp>
+
+static jive::theta_node *
+create_theta(
+	jive::output * init,
+	jive::output * end,
+	jive::output * state)
+{
+	using namespace jive;
+
+	auto graph = init->region()->graph();
+
+	auto theta = theta_node::create(graph->root());
+	auto subregion = theta->subregion();
+	auto idv = theta->add_loopvar(init);
+	auto lve = theta->add_loopvar(end);
+	theta->add_loopvar(state);
+
+	auto one = create_bitconstant(subregion, 32, 1);
+	auto arm = bitadd_op::create(32, idv->argument(), one);
+	auto cmp = bitult_op::create(32, arm, lve->argument());
+	auto match = jive::match(1, {{1, 1}}, 0, 2, cmp);
+
+	idv->result()->divert_to(arm);
+	theta->set_predicate(match);
+
+	return theta;
+}
+
+static inline void
+test_known()
+{
+	jlm::loopstatetype lt;
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto l = graph.add_import({lt, "l"});
+	auto init = jive::create_bitconstant(graph.root(), 32, 0);
+	auto end = jive::create_bitconstant(graph.root(), 32, 100);
+
+	auto theta = create_theta(init, end, l);
+	auto ex = graph.add_export(theta->output(2), {lt, "l"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::delete_loops(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(ex->origin() == l);
+	for (const auto & node : graph.root()->nodes)
+		assert(!jive::is<jive::theta_op>(&node));
+}
+
+static inline void
+test_unknown()
+{
+	jlm::loopstatetype lt;
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto l = graph.add_import({lt, "l"});
+	auto n = graph.add_import({bt32, "n"});
+	auto init = jive::create_bitconstant(graph.root(), 32, 0);
+
+	auto theta = create_theta(init, n, l);
+	auto ex = graph.add_export(theta->output(2), {lt, "l"});
+
+	assert(!jlm::delete_loop(theta));
+	assert(ex->origin() == theta->output(2));
+}
+
+static int
+verify()
+{
+	test_known();
+	test_unknown();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-loopdeletion", verify)
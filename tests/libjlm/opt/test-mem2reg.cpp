@@ -0,0 +1,109 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/arch/addresstype.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/theta.h>
+
+#include <jlm/ir/operators/alloca.hpp>
+#include <jlm/ir/operators/load.hpp>
+#include <jlm/ir/operators/store.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/mem2reg.hpp>
+
+static bool
+contains_memory_access(const jive::region * region)
+{
+	for (const auto & node : region->nodes) {
+		if (jive::is<jlm::load_op>(&node) || jive::is<jlm::store_op>(&node))
+			return true;
+
+		if (auto structnode = dynamic_cast<const jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++) {
+				if (contains_memory_access(structnode->subregion(n)))
+					return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+static inline void
+test_gamma()
+{
+	jlm::valuetype vt;
+	jive::memtype mt;
+	jive::ctltype ct(2);
+
+	jive::graph graph;
+	auto c = graph.add_import({ct, "c"});
+	auto v1 = graph.add_import({vt, "v1"});
+	auto v2 = graph.add_import({vt, "v2"});
+	auto s = graph.add_import({mt, "s"});
+
+	auto size = jive::create_bitconstant(graph.root(), 32, 1);
+	auto alloca = jlm::create_alloca(vt, size, s, 4);
+	auto st = jlm::create_store(alloca[0], v1, {alloca[1]}, 4);
+
+	auto gamma = jive::gamma_node::create(c, 2);
+	auto eva = gamma->add_entryvar(alloca[0]);
+	auto evv = gamma->add_entryvar(v2);
+	auto evs = gamma->add_entryvar(st[0]);
+
+	auto st0 = jlm::create_store(eva->argument(0), evv->argument(0), {evs->argument(0)}, 4);
+	auto xvs = gamma->add_exitvar({st0[0], evs->argument(1)});
+
+	auto ld = jlm::create_load(alloca[0], {xvs}, 4);
+
+	auto exv = graph.add_export(ld[0], {vt, "v"});
+	auto exs = graph.add_export(ld[1], {mt, "s"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::mem2reg(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(!contains_memory_access(graph.root()));
+	assert(exv->origin()->node() == gamma);
+	assert(exs->origin() == gamma->output(xvs->index()));
+}
+
+static inline void
+test_escape()
+{
+	jlm::valuetype vt;
+	jlm::ptrtype pt(vt);
+	jive::memtype mt;
+
+	jive::graph graph;
+	auto s = graph.add_import({mt, "s"});
+
+	auto size = jive::create_bitconstant(graph.root(), 32, 1);
+	auto alloca = jlm::create_alloca(vt, size, s, 4);
+
+	graph.add_export(alloca[0], {pt, "a"});
+	graph.add_export(alloca[1], {mt, "s"});
+
+	jlm::mem2reg(graph);
+
+	assert(alloca[0]->nusers() == 1);
+}
+
+static int
+verify()
+{
+	test_gamma();
+	test_escape();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-mem2reg", verify)
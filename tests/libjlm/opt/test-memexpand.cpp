@@ -0,0 +1,99 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/arch/addresstype.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/opt/memexpand.hpp>
+
+static size_t
+count(const jive::region * region, const std::type_info & type)
+{
+	size_t n = 0;
+	for (const auto & node : region->nodes) {
+		if (typeid(node.operation()) == type)
+			n++;
+	}
+
+	return n;
+}
+
+static inline void
+test_memcpy()
+{
+	jive::bittype bt8(8);
+	jlm::ptrtype pt(bt8);
+	jive::memtype mt;
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto d = graph.add_import({pt, "d"});
+	auto s = graph.add_import({pt, "s"});
+	auto m = graph.add_import({mt, "m"});
+
+	auto length = jive::create_bitconstant(graph.root(), 64, 12);
+	auto states = jlm::create_memcpy(d, s, length, {m}, 4);
+
+	auto ex = graph.add_export(states[0], {mt, "m"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::expand_memops(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(count(graph.root(), typeid(jlm::memcpy_op)) == 0);
+	assert(count(graph.root(), typeid(jlm::load_op)) == 2);
+	assert(count(graph.root(), typeid(jlm::store_op)) == 2);
+	assert(jive::is<jlm::store_op>(ex->origin()->node()));
+}
+
+static inline void
+test_memset()
+{
+	jive::bittype bt8(8);
+	jlm::ptrtype pt(bt8);
+	jive::memtype mt;
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto d = graph.add_import({pt, "d"});
+	auto v = graph.add_import({bt8, "v"});
+	auto m = graph.add_import({mt, "m"});
+
+	auto zero = jive::create_bitconstant(graph.root(), 8, 0);
+	auto l1 = jive::create_bitconstant(graph.root(), 64, 3);
+	auto l2 = jive::create_bitconstant(graph.root(), 64, 64);
+	auto s1 = jlm::create_memset(d, zero, l1, {m}, 2);
+	auto s2 = jlm::create_memset(d, v, l1, s1, 2);
+	auto s3 = jlm::create_memset(d, v, l2, s2, 2);
+
+	graph.add_export(s3[0], {mt, "m"});
+
+	jlm::expand_memops(graph);
+
+	/* a 2-byte and a 1-byte store for the constant, and three 1-byte stores otherwise */
+	assert(count(graph.root(), typeid(jlm::store_op)) == 5);
+	assert(count(graph.root(), typeid(jlm::memset_op)) == 1);
+}
+
+static int
+verify()
+{
+	test_memcpy();
+	test_memset();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-memexpand", verify)
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/arch/addresstype.h>
+#include <jive/rvsdg/statemux.h>
+#include <jive/view.h>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/opt/cne.hpp>
+#include <jlm/opt/modref.hpp>
+
+static void
+test_summaries()
+{
+	using namespace jlm;
+
+	jlm::valuetype vt;
+	jlm::ptrtype pt(vt);
+	jive::memtype mt;
+	jlm::loopstatetype lt;
+	jive::fcttype ft({&pt, &mt, &lt}, {&vt, &mt, &lt});
+	jive::fcttype gt({&pt, &mt, &lt}, {&mt, &lt});
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	/* pure function */
+	jlm::lambda_builder lb;
+	auto arguments = lb.begin_lambda(graph.root(), {ft, "pure", linkage::external_linkage});
+	auto v = create_testop(lb.subregion(), {arguments[0]}, {&vt})[0];
+	auto pure = lb.end_lambda({v, arguments[1], arguments[2]})->output(0);
+
+	/* read-only function */
+	arguments = lb.begin_lambda(graph.root(), {ft, "ro", linkage::external_linkage});
+	auto ld = create_load(arguments[0], {arguments[1]}, 4);
+	auto ro = lb.end_lambda({ld[0], ld[1], arguments[2]})->output(0);
+
+	/* caller */
+	arguments = lb.begin_lambda(graph.root(), {gt, "g", linkage::external_linkage});
+	auto dpure = lb.add_dependency(pure);
+	auto dro = lb.add_dependency(ro);
+	auto c1 = create_call(dpure, {arguments[0], arguments[1], arguments[2]});
+	auto c2 = create_call(dro, {arguments[0], c1[1], c1[2]});
+	auto c3 = create_call(dro, {arguments[0], c2[1], c2[2]});
+	auto st = create_store(arguments[0], c1[0], {c3[1]}, 4);
+	auto g = lb.end_lambda({st[0], c3[2]});
+
+	graph.add_export(g->output(0), {g->output(0)->type(), "g"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::modref(graph);
+//	jive::view(graph.root(), stdout);
+
+	/* the pure call is bypassed */
+	assert(c2[0]->node()->input(2)->origin() == arguments[1]);
+	assert(c2[0]->node()->input(3)->origin() == arguments[2]);
+
+	/* the read-only calls share the memory state */
+	assert(c3[0]->node()->input(2)->origin() == arguments[1]);
+	auto mux = st[0]->node()->input(2)->origin()->node();
+	assert(jive::is<jive::mux_op>(mux));
+
+	/* neither function loops */
+	assert(g->subregion()->result(1)->origin() == arguments[2]);
+}
+
+static void
+test_congruent_calls()
+{
+	using namespace jlm;
+
+	jlm::valuetype vt;
+	jlm::ptrtype pt(vt);
+	jive::memtype mt;
+	jlm::loopstatetype lt;
+	jive::fcttype ft({&pt, &mt, &lt}, {&vt, &mt, &lt});
+	jive::fcttype gt({&pt, &mt, &lt}, {&mt, &lt});
+
+	jive::graph graph;
+
+	jlm::lambda_builder lb;
+	auto arguments = lb.begin_lambda(graph.root(), {ft, "pure", linkage::external_linkage});
+	auto v = create_testop(lb.subregion(), {arguments[0]}, {&vt})[0];
+	auto pure = lb.end_lambda({v, arguments[1], arguments[2]})->output(0);
+
+	arguments = lb.begin_lambda(graph.root(), {gt, "g", linkage::external_linkage});
+	auto dpure = lb.add_dependency(pure);
+	auto c1 = create_call(dpure, {arguments[0], arguments[1], arguments[2]});
+	auto st1 = create_store(arguments[0], c1[0], {c1[1]}, 4);
+	auto c2 = create_call(dpure, {arguments[0], st1[0], c1[2]});
+	auto st2 = create_store(arguments[0], c2[0], {st1[0]}, 4);
+	auto g = lb.end_lambda({st2[0], c2[2]});
+
+	graph.add_export(g->output(0), {g->output(0)->type(), "g"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::modref(graph);
+	jlm::cne(graph);
+//	jive::view(graph.root(), stdout);
+
+	/* both calls ignore the store in between and are merged */
+	assert(st1[0]->node()->input(1)->origin() == st2[0]->node()->input(1)->origin());
+}
+
+static int
+verify()
+{
+	test_summaries();
+	test_congruent_calls();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-modref", verify)
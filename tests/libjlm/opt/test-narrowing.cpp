@@ -0,0 +1,157 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+#include <jive/rvsdg/graph.h>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/opt/narrowing.hpp>
+
+static inline void
+test_mask()
+{
+	using namespace jive;
+
+	jive::bittype bt8(8);
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto x = graph.add_import({bt8, "x"});
+	auto y = graph.add_import({bt32, "y"});
+
+	/* the mask only clears bits that are known to be zero */
+	auto zext = jlm::create_zext(32, x);
+	auto c255 = create_bitconstant(graph.root(), 32, 255);
+	auto and1 = bitand_op::create(32, zext, c255);
+
+	/* the mask only clears bits that are not demanded */
+	auto c1023 = create_bitconstant(graph.root(), 32, 1023);
+	auto and2 = bitand_op::create(32, y, c1023);
+	auto trunc = jlm::create_trunc(8, and2);
+
+	auto ex1 = graph.add_export(and1, {and1->type(), "a"});
+	auto ex2 = graph.add_export(trunc, {trunc->type(), "b"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::narrow(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(ex1->origin() == zext);
+	assert(ex2->origin()->node()->input(0)->origin() == y);
+}
+
+static inline void
+test_stale_known_bits()
+{
+	using namespace jive;
+
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto x = graph.add_import({bt32, "x"});
+
+	/* z = ((x & 0xFF) ^ 1) & 0xFF */
+	auto c255 = create_bitconstant(graph.root(), 32, 255);
+	auto one = create_bitconstant(graph.root(), 32, 1);
+	auto v = bitand_op::create(32, x, c255);
+	auto w = bitxor_op::create(32, v, one);
+	auto z = bitand_op::create(32, w, c255);
+
+	auto ex = graph.add_export(z, {bt32, "z"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::narrow(graph);
+//	jive::view(graph.root(), stdout);
+
+	/* only one of the masks can be removed */
+	auto origin = ex->origin();
+	if (origin == w)
+		assert(w->node()->input(0)->origin() == v);
+	else
+		assert(origin == z && z->node()->input(0)->origin() == w);
+}
+
+static inline void
+test_sext()
+{
+	using namespace jive;
+
+	jive::bittype bt8(8);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto x = graph.add_import({bt8, "x"});
+
+	auto one = create_bitconstant(graph.root(), 8, 1);
+	auto shr = bitshr_op::create(8, x, one);
+	auto sext = jlm::create_sext(32, shr);
+
+	auto ex = graph.add_export(sext, {sext->type(), "x"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::narrow(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(jive::is<jlm::zext_op>(ex->origin()->node()));
+}
+
+static inline void
+test_arithmetic()
+{
+	using namespace jive;
+
+	jive::bittype bt8(8);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto x = graph.add_import({bt8, "x"});
+	auto y = graph.add_import({bt8, "y"});
+
+	auto zx = jlm::create_zext(32, x);
+	auto zy = jlm::create_zext(32, y);
+	auto add = bitadd_op::create(32, zx, zy);
+	auto trunc = jlm::create_trunc(8, add);
+
+	auto ex = graph.add_export(trunc, {trunc->type(), "x"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::narrow(graph);
+//	jive::view(graph.root(), stdout);
+
+	auto zext = ex->origin()->node()->input(0)->origin()->node();
+	assert(jive::is<jlm::zext_op>(zext));
+
+	assert(jive::is<bitadd_op>(zext->input(0)->origin()->node()));
+	assert(zext->input(0)->type() == bt8);
+}
+
+static int
+verify()
+{
+	test_mask();
+	test_stale_known_bits();
+	test_sext();
+	test_arithmetic();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-narrowing", verify)
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/simple-node.h>
+#include <jive/rvsdg/theta.h>
+
+#include <jlm/opt/peeling.hpp>
+
+static inline void
+test_peel()
+{
+	jlm::valuetype vt;
+	jive::ctltype ct(2);
+
+	jive::graph graph;
+	auto c = graph.add_import({ct, "c"});
+	auto x = graph.add_import({vt, "x"});
+
+	auto theta = jive::theta_node::create(graph.root());
+	auto lvc = theta->add_loopvar(c);
+	auto lvx = theta->add_loopvar(x);
+
+	auto y = jlm::create_testop(theta->subregion(), {lvx->argument()}, {&vt})[0];
+
+	lvx->result()->divert_to(y);
+	theta->set_predicate(lvc->argument());
+
+	auto ex = graph.add_export(lvx, {lvx->type(), "x"});
+
+//	jive::view(graph.root(), stdout);
+	auto ntheta = jlm::peel(theta, 2);
+//	jive::view(graph.root(), stdout);
+
+	auto gamma = dynamic_cast<jive::gamma_node*>(ex->origin()->node());
+	assert(gamma && gamma->subregion(1)->nnodes() == 2);
+	assert(ntheta->region()->node()->region() == gamma->subregion(1));
+}
+
+static inline void
+test_first_iteration(size_t budget)
+{
+	jlm::valuetype vt;
+	jive::ctltype ct(2);
+
+	jive::graph graph;
+	auto c = graph.add_import({ct, "c"});
+	auto x = graph.add_import({vt, "x"});
+	auto f = graph.add_import({vt, "f"});
+
+	auto theta = jive::theta_node::create(graph.root());
+	auto lvc = theta->add_loopvar(c);
+	auto lvx = theta->add_loopvar(x);
+	auto lvf = theta->add_loopvar(f);
+
+	auto flag = jlm::create_testop(theta->subregion(), {}, {&vt})[0];
+	auto y = jlm::create_testop(theta->subregion(), {lvx->argument(), lvf->argument()}, {&vt})[0];
+
+	lvx->result()->divert_to(y);
+	lvf->result()->divert_to(flag);
+	theta->set_predicate(lvc->argument());
+
+	auto ex = graph.add_export(lvf, {lvf->type(), "f"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::peel(graph, budget);
+//	jive::view(graph.root(), stdout);
+
+	/* the theta node exceeds the budget and is left alone */
+	if (budget < 2) {
+		assert(ex->origin()->node() == theta);
+		return;
+	}
+
+	auto gamma = dynamic_cast<jive::gamma_node*>(ex->origin()->node());
+	assert(gamma);
+
+	auto ntheta = dynamic_cast<jive::theta_node*>(&*gamma->subregion(1)->nodes.begin());
+	assert(ntheta);
+	auto nlvf = ntheta->output(2);
+	assert(nlvf->result()->origin() == nlvf->argument());
+}
+
+static int
+verify()
+{
+	test_peel();
+	test_first_iteration(500);
+	test_first_iteration(1);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-peeling", verify)
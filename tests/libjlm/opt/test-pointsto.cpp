@@ -0,0 +1,89 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/arch/addresstype.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+#include <jive/rvsdg/statemux.h>
+
+#include <jlm/ir/operators/alloca.hpp>
+#include <jlm/ir/operators/load.hpp>
+#include <jlm/ir/operators/store.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/pointsto.hpp>
+
+static inline void
+test_analysis()
+{
+	jlm::valuetype vt;
+	jlm::ptrtype pt(vt);
+	jive::memtype mt;
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto p = graph.add_import({pt, "p"});
+	auto s = graph.add_import({mt, "s"});
+
+	auto size = jive::create_bitconstant(graph.root(), 32, 1);
+	auto a1 = jlm::create_alloca(vt, size, s, 4);
+	auto a2 = jlm::create_alloca(vt, size, a1[1], 4);
+
+	graph.add_export(a2[1], {mt, "s"});
+
+	auto pts = jlm::pointsto::analyze(graph);
+	assert(!pts->may_alias(a1[0], a2[0]));
+	assert(pts->may_alias(a1[0], a1[0]));
+	assert(pts->may_alias(a1[0], p));
+	assert(pts->is_unknown(pts->memclass(p)));
+}
+
+static inline void
+test_split()
+{
+	jlm::valuetype vt;
+	jlm::ptrtype pt(vt);
+	jive::memtype mt;
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto v = graph.add_import({vt, "v"});
+	auto s = graph.add_import({mt, "s"});
+
+	auto size = jive::create_bitconstant(graph.root(), 32, 1);
+	auto a1 = jlm::create_alloca(vt, size, s, 4);
+	auto a2 = jlm::create_alloca(vt, size, a1[1], 4);
+
+	auto s1 = jlm::create_store(a1[0], v, {a2[1]}, 4);
+	auto s2 = jlm::create_store(a2[0], v, s1, 4);
+	auto ld = jlm::create_load(a1[0], s2, 4);
+
+	graph.add_export(ld[0], {vt, "v"});
+	auto ex = graph.add_export(ld[1], {mt, "s"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::split_memory_states(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(ld[0]->node()->input(1)->origin() == s1[0]);
+	assert(s2[0]->node()->input(2)->origin() == a2[1]);
+	assert(jive::is<jive::mux_op>(ex->origin()->node()));
+}
+
+static int
+verify()
+{
+	test_analysis();
+	test_split();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-pointsto", verify)
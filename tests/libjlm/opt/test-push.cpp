@@ -13,6 +13,7 @@
 #include <jive/rvsdg/simple-node.h>
 #include <jive/rvsdg/theta.h>
 
+#include <jlm/ir/operators/load.hpp>
 #include <jlm/ir/operators/store.hpp>
 #include <jlm/ir/types.hpp>
 #include <jlm/opt/push.hpp>
@@ -129,12 +130,54 @@ test_push_theta_bottom()
 	assert(jive::is<jive::theta_op>(storenode->input(2)->origin()->node()));
 }
 
+static inline void
+test_push_theta_load()
+{
+	jive::memtype mt;
+	jlm::valuetype vt;
+	jlm::ptrtype pt(vt);
+	jive::ctltype ct(2);
+
+	jive::graph graph;
+	auto c = graph.add_import({ct, "c"});
+	auto a = graph.add_import({pt, "a"});
+	auto x = graph.add_import({vt, "x"});
+	auto s = graph.add_import({mt, "s"});
+
+	auto theta = jive::theta_node::create(graph.root());
+
+	auto lvc = theta->add_loopvar(c);
+	auto lva = theta->add_loopvar(a);
+	auto lvx = theta->add_loopvar(x);
+	auto lvs = theta->add_loopvar(s);
+
+	auto ld = jlm::create_load(lva->argument(), {lvs->argument()}, 4);
+	auto sum = jlm::create_testop(theta->subregion(), {ld[0], lvx->argument()}, {&vt})[0];
+
+	lvx->result()->divert_to(sum);
+	theta->set_predicate(lvc->argument());
+
+	graph.add_export(lvx, {lvx->type(), "x"});
+	graph.add_export(lvs, {lvs->type(), "s"});
+
+//	jive::view(graph, stdout);
+	jlm::push_top(theta);
+//	jive::view(graph, stdout);
+
+	auto loadnode = lvs->input()->origin()->node();
+	assert(jive::is<jlm::load_op>(loadnode));
+	assert(loadnode->input(0)->origin() == a);
+	assert(loadnode->input(1)->origin() == s);
+	assert(theta->subregion()->nnodes() == 1);
+}
+
 static int
 verify()
 {
 	test_gamma();
 	test_theta();
 	test_push_theta_bottom();
+	test_push_theta_load();
 
 	return 0;
 }
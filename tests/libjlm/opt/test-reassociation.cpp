@@ -0,0 +1,71 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+#include <jive/rvsdg/graph.h>
+
+#include <jlm/opt/reassociation.hpp>
+
+static inline bool
+is_add(const jive::output * output, const jive::output * op1, const jive::output * op2)
+{
+	auto node = output->node();
+	return jive::is<jive::bitadd_op>(node)
+	    && node->input(0)->origin() == op1
+	    && node->input(1)->origin() == op2;
+}
+
+static int
+verify()
+{
+	using namespace jive;
+
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto a = graph.add_import({bt32, "a"});
+	auto b = graph.add_import({bt32, "b"});
+	auto c = graph.add_import({bt32, "c"});
+	auto one = create_bitconstant(graph.root(), 32, 1);
+	auto two = create_bitconstant(graph.root(), 32, 2);
+
+	auto e1 = bitadd_op::create(32, bitadd_op::create(32, a, b), c);
+	auto e2 = bitadd_op::create(32, a, bitadd_op::create(32, c, b));
+	auto e3 = bitadd_op::create(32, bitadd_op::create(32, one, a), two);
+
+	auto ex1 = graph.add_export(e1, {bt32, "e1"});
+	auto ex2 = graph.add_export(e2, {bt32, "e2"});
+	auto ex3 = graph.add_export(e3, {bt32, "e3"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::reassociate(graph);
+//	jive::view(graph.root(), stdout);
+
+	/* both trees are rebuilt as (a + b) + c */
+	auto o1 = ex1->origin(), o2 = ex2->origin();
+	assert(is_add(o1, o1->node()->input(0)->origin(), c));
+	assert(is_add(o1->node()->input(0)->origin(), a, b));
+	assert(is_add(o2, o2->node()->input(0)->origin(), c));
+	assert(is_add(o2->node()->input(0)->origin(), a, b));
+
+	/* the constants are folded into a + 3 */
+	auto o3 = ex3->origin();
+	assert(is_add(o3, a, o3->node()->input(1)->origin()));
+	auto cop = dynamic_cast<const bitconstant_op*>(&o3->node()->input(1)->origin()->node()->operation());
+	assert(cop && cop->value().to_uint() == 3);
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-reassociation", verify)
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/comparison.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/theta.h>
+
+#include <jlm/opt/sccp.hpp>
+
+static inline void
+test_gamma()
+{
+	using namespace jive;
+
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto x = graph.add_import({bt32, "x"});
+	auto y = graph.add_import({bt32, "y"});
+	auto p = graph.add_import({bt32, "p"});
+
+	/* the loop keeps c constant */
+	auto c = create_bitconstant(graph.root(), 32, 1);
+
+	auto theta = theta_node::create(graph.root());
+	auto lvc = theta->add_loopvar(c);
+	auto lvp = theta->add_loopvar(p);
+	theta->set_predicate(jive::match(32, {{0, 0}}, 1, 2, lvp->argument()));
+
+	auto match = jive::match(32, {{1, 1}}, 0, 2, lvc);
+	auto gamma = gamma_node::create(match, 2);
+	auto evx = gamma->add_entryvar(x);
+	auto evy = gamma->add_entryvar(y);
+	auto ex = gamma->add_exitvar({evx->argument(0), evy->argument(1)});
+
+	graph.add_export(ex, {bt32, "z"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::sccp(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(graph.root()->result(0)->origin() == y);
+	for (const auto & node : graph.root()->nodes)
+		assert(!jive::is<jive::gamma_op>(&node));
+}
+
+static inline void
+test_theta()
+{
+	using namespace jive;
+
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto x = graph.add_import({bt32, "x"});
+	auto c = create_bitconstant(graph.root(), 32, 5);
+
+	/* the predicate evaluates to exit in the first iteration */
+	auto theta = theta_node::create(graph.root());
+	auto lvx = theta->add_loopvar(x);
+	auto lvc = theta->add_loopvar(c);
+
+	auto one = create_bitconstant(theta->subregion(), 32, 1);
+	auto add = bitadd_op::create(32, lvx->argument(), one);
+	auto cmp = bitult_op::create(32, lvc->argument(), one);
+	lvx->result()->divert_to(add);
+	theta->set_predicate(jive::match(1, {{1, 1}}, 0, 2, cmp));
+
+	graph.add_export(lvx, {bt32, "y"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::sccp(graph);
+//	jive::view(graph.root(), stdout);
+
+	for (const auto & node : graph.root()->nodes)
+		assert(!jive::is<jive::theta_op>(&node));
+
+	auto node = graph.root()->result(0)->origin()->node();
+	assert(jive::is<jive::bitadd_op>(node) && node->input(0)->origin() == x);
+}
+
+static int
+verify()
+{
+	test_gamma();
+	test_theta();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-sccp", verify)
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+
+#include <jlm/ir/operators/alloca.hpp>
+#include <jlm/ir/operators/getelementptr.hpp>
+#include <jlm/ir/operators/load.hpp>
+#include <jlm/ir/operators/store.hpp>
+#include <jlm/ir/types.hpp>
+#include <jlm/opt/sra.hpp>
+
+static inline jive::output *
+create_gep(jive::output * address, const std::vector<jive::output*> & indices, const jive::valuetype & type)
+{
+	std::vector<jive::bittype> btypes;
+	for (const auto & index : indices)
+		btypes.push_back(*static_cast<const jive::bittype*>(&index->type()));
+
+	auto & at = *static_cast<const jlm::ptrtype*>(&address->type());
+	jlm::getelementptr_op op(at, btypes, jlm::ptrtype(type));
+
+	std::vector<jive::output*> operands(1, address);
+	operands.insert(operands.end(), indices.begin(), indices.end());
+	return jive::simple_node::create_normalized(address->region(), op, operands)[0];
+}
+
+static inline void
+test_array()
+{
+	jlm::valuetype vt;
+	jlm::arraytype at(vt, 2);
+	jive::memtype mt;
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto v = graph.add_import({vt, "v"});
+	auto s = graph.add_import({mt, "s"});
+
+	auto zero = jive::create_bitconstant(graph.root(), 32, 0);
+	auto one = jive::create_bitconstant(graph.root(), 32, 1);
+	auto alloca = jlm::create_alloca(at, one, s, 4);
+
+	auto a0 = create_gep(alloca[0], {zero, zero}, vt);
+	auto a1 = create_gep(alloca[0], {zero, one}, vt);
+	auto s1 = jlm::create_store(a0, v, {alloca[1]}, 4);
+	auto s2 = jlm::create_store(a1, v, {s1[0]}, 4);
+	auto ld = jlm::create_load(a0, s2, 4);
+
+	graph.add_export(ld[0], {vt, "v"});
+	graph.add_export(ld[1], {mt, "s"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::sra(graph);
+//	jive::view(graph.root(), stdout);
+
+	auto e0 = ld[0]->node()->input(0)->origin()->node();
+	auto e1 = s2[0]->node()->input(0)->origin()->node();
+	assert(jlm::is<jlm::alloca_op>(e0) && jlm::is<jlm::alloca_op>(e1) && e0 != e1);
+	assert(s1[0]->node()->input(0)->origin() == e0->output(0));
+	assert(s1[0]->node()->input(2)->origin()->node() == e0 || s1[0]->node()->input(2)->origin()->node() == e1);
+}
+
+static inline void
+test_escape()
+{
+	jlm::valuetype vt;
+	jlm::arraytype at(vt, 2);
+	jlm::ptrtype pt(at);
+	jive::memtype mt;
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto s = graph.add_import({mt, "s"});
+
+	auto one = jive::create_bitconstant(graph.root(), 32, 1);
+	auto alloca = jlm::create_alloca(at, one, s, 4);
+
+	auto ex = graph.add_export(alloca[0], {pt, "p"});
+	graph.add_export(alloca[1], {mt, "s"});
+
+	jlm::sra(graph);
+
+	assert(ex->origin() == alloca[0]);
+}
+
+static inline void
+test_element_escape()
+{
+	jlm::valuetype vt;
+	jlm::arraytype at(vt, 2);
+	jive::memtype mt;
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto v = graph.add_import({vt, "v"});
+	auto s = graph.add_import({mt, "s"});
+
+	auto zero = jive::create_bitconstant(graph.root(), 32, 0);
+	auto one = jive::create_bitconstant(graph.root(), 32, 1);
+	auto alloca = jlm::create_alloca(at, one, s, 4);
+
+	/* p = &a[0]; p[1] = v */
+	auto p = create_gep(alloca[0], {zero, zero}, vt);
+	auto p1 = create_gep(p, {one}, vt);
+	auto st = jlm::create_store(p1, v, {alloca[1]}, 4);
+
+	graph.add_export(st[0], {mt, "s"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::sra(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(p1->node()->input(0)->origin() == p);
+	assert(p->node()->input(0)->origin() == alloca[0]);
+}
+
+static int
+verify()
+{
+	test_array();
+	test_escape();
+	test_element_escape();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-sra", verify)
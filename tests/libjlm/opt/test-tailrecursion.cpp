@@ -0,0 +1,89 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.h>
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/phi.h>
+#include <jive/rvsdg/theta.h>
+
+#include <jlm/ir/operators.hpp>
+#include <jlm/opt/tailrecursion.hpp>
+
+static bool
+contains_call_node(const jive::region * region)
+{
+	for (const auto & node : region->nodes) {
+		if (jive::is<jlm::call_op>(&node))
+			return true;
+
+		if (auto structnode = dynamic_cast<const jive::structural_node*>(&node)) {
+			for (size_t n = 0; n < structnode->nsubregions(); n++) {
+				if (contains_call_node(structnode->subregion(n)))
+					return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+static int
+verify()
+{
+	using namespace jlm;
+
+	jlm::valuetype vt;
+	jlm::statetype st;
+	jive::fcttype ft({&vt, &st}, {&vt, &st});
+	jlm::ptrtype pt(ft);
+
+	jive::graph graph;
+
+	jive::phi_builder pb;
+	pb.begin_phi(graph.root());
+	auto rv = pb.add_recvar(pt);
+
+	jlm::lambda_builder lb;
+	auto arguments = lb.begin_lambda(pb.region(), {ft, "f", linkage::external_linkage});
+	auto d = lb.add_dependency(rv->value());
+
+	auto c = jlm::create_testop(lb.subregion(), {arguments[0]}, {&jive::bit1})[0];
+	auto predicate = jive::match(1, {{1, 1}}, 0, 2, c);
+
+	auto gamma = jive::gamma_node::create(predicate, 2);
+	auto evx = gamma->add_entryvar(arguments[0]);
+	auto evs = gamma->add_entryvar(arguments[1]);
+	auto evf = gamma->add_entryvar(d);
+
+	auto r = jlm::create_testop(gamma->subregion(0), {evx->argument(0)}, {&vt})[0];
+	auto x = jlm::create_testop(gamma->subregion(1), {evx->argument(1)}, {&vt})[0];
+	auto call = jlm::create_call(evf->argument(1), {x, evs->argument(1)});
+
+	auto xvx = gamma->add_exitvar({r, call[0]});
+	auto xvs = gamma->add_exitvar({evs->argument(0), call[1]});
+	auto f = lb.end_lambda({xvx, xvs});
+
+	rv->set_value(f->output(0));
+	auto phi = pb.end_phi();
+
+	graph.add_export(phi->output(0), {phi->output(0)->type(), "f"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::eliminate_tail_recursion(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(!contains_call_node(graph.root()));
+	assert(jive::is<jive::theta_op>(f->subregion()->result(0)->origin()->node()));
+	assert(jive::is<jive::theta_op>(f->subregion()->result(1)->origin()->node()));
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-tailrecursion", verify)
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/view.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/simple-node.h>
+#include <jive/rvsdg/theta.h>
+
+#include <jlm/opt/unswitch.hpp>
+
+static inline void
+test_unswitch()
+{
+	jlm::valuetype vt;
+	jive::ctltype ct(2);
+
+	jive::graph graph;
+	auto c = graph.add_import({ct, "c"});
+	auto p = graph.add_import({ct, "p"});
+	auto x = graph.add_import({vt, "x"});
+
+	auto theta = jive::theta_node::create(graph.root());
+
+	auto lvc = theta->add_loopvar(c);
+	auto lvp = theta->add_loopvar(p);
+	auto lvx = theta->add_loopvar(x);
+
+	auto gamma = jive::gamma_node::create(lvp->argument(), 2);
+	auto evx = gamma->add_entryvar(lvx->argument());
+
+	auto o0 = jlm::create_testop(gamma->subregion(0), {evx->argument(0)}, {&vt})[0];
+	auto o1 = jlm::create_testop(gamma->subregion(1), {evx->argument(1)}, {&vt})[0];
+	auto xv = gamma->add_exitvar({o0, o1});
+
+	auto y = jlm::create_testop(theta->subregion(), {xv}, {&vt})[0];
+
+	lvx->result()->divert_to(y);
+	theta->set_predicate(lvc->argument());
+
+	auto ex = graph.add_export(lvx, {lvx->type(), "x"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::unswitch(graph, 500);
+//	jive::view(graph.root(), stdout);
+
+	auto ngamma = dynamic_cast<jive::gamma_node*>(ex->origin()->node());
+	assert(ngamma && ngamma->predicate()->origin() == p);
+	for (size_t r = 0; r < ngamma->nsubregions(); r++) {
+		auto subregion = ngamma->subregion(r);
+		assert(subregion->nnodes() == 1);
+
+		auto ntheta = dynamic_cast<jive::theta_node*>(&*subregion->nodes.begin());
+		assert(ntheta && ntheta->subregion()->nnodes() == 2);
+		for (auto & node : ntheta->subregion()->nodes)
+			assert(!jive::is<jive::gamma_op>(&node));
+	}
+}
+
+static inline void
+test_budget()
+{
+	jlm::valuetype vt;
+	jive::ctltype ct(2);
+
+	jive::graph graph;
+	auto c = graph.add_import({ct, "c"});
+	auto p = graph.add_import({ct, "p"});
+	auto x = graph.add_import({vt, "x"});
+
+	auto theta = jive::theta_node::create(graph.root());
+
+	auto lvc = theta->add_loopvar(c);
+	auto lvp = theta->add_loopvar(p);
+	auto lvx = theta->add_loopvar(x);
+
+	auto gamma = jive::gamma_node::create(lvp->argument(), 2);
+	auto evx = gamma->add_entryvar(lvx->argument());
+	auto xv = gamma->add_exitvar({evx->argument(0), evx->argument(1)});
+
+	lvx->result()->divert_to(xv);
+	theta->set_predicate(lvc->argument());
+
+	graph.add_export(lvx, {lvx->type(), "x"});
+
+	assert(!jlm::unswitch(theta, 1));
+	assert(graph.root()->nnodes() == 1);
+	assert(jive::is<jive::theta_op>(&*graph.root()->nodes.begin()));
+}
+
+static int
+verify()
+{
+	test_unswitch();
+	test_budget();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-unswitch", verify)
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2018 Nico Reißmann <nico.reissmann@gmail.com>
+ * See COPYING for terms of redistribution.
+ */
+
+#include "test-operation.hpp"
+#include "test-registry.hpp"
+#include "test-types.hpp"
+
+#include <jive/types/bitstring/arithmetic.h>
+#include <jive/types/bitstring/comparison.h>
+#include <jive/types/bitstring/constant.h>
+#include <jive/view.h>
+#include <jive/rvsdg/control.h>
+#include <jive/rvsdg/gamma.h>
+#include <jive/rvsdg/graph.h>
+#include <jive/rvsdg/theta.h>
+
+#include <jlm/opt/vra.hpp>
+
+static inline bool
+is_true(const jive::output * output)
+{
+	auto op = dynamic_cast<const jive::bitconstant_op*>(&output->node()->operation());
+	return op && op->value().to_uint() == 1;
+}
+
+static inline void
+test_theta()
+{
+	using namespace jive;
+
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto zero = create_bitconstant(graph.root(), 32, 0);
+	auto f = create_bitconstant(graph.root(), 1, 0);
+
+	/* for (i = 0; i < 100; i++) check(i < 100) */
+	auto theta = theta_node::create(graph.root());
+	auto subregion = theta->subregion();
+	auto lv = theta->add_loopvar(zero);
+	auto lvc = theta->add_loopvar(f);
+
+	auto hundred = create_bitconstant(subregion, 32, 100);
+	auto check = bitslt_op::create(32, lv->argument(), hundred);
+
+	auto one = create_bitconstant(subregion, 32, 1);
+	auto add = bitadd_op::create(32, lv->argument(), one);
+	auto cmp = bitult_op::create(32, add, hundred);
+	lv->result()->divert_to(add);
+	lvc->result()->divert_to(check);
+	theta->set_predicate(jive::match(1, {{1, 1}}, 0, 2, cmp));
+
+	graph.add_export(lv, {bt32, "i"});
+	graph.add_export(lvc, {jive::bit1, "c"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::vra(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(is_true(lvc->result()->origin()));
+}
+
+static inline void
+test_gamma()
+{
+	using namespace jive;
+
+	jive::bittype bt32(32);
+
+	jive::graph graph;
+	auto nf = graph.node_normal_form(typeid(jive::operation));
+	nf->set_mutable(false);
+
+	auto x = graph.add_import({bt32, "x"});
+
+	/* if (x < 10) return x < 20 */
+	auto ten = create_bitconstant(graph.root(), 32, 10);
+	auto cmp = bitult_op::create(32, x, ten);
+	auto gamma = gamma_node::create(jive::match(1, {{1, 1}}, 0, 2, cmp), 2);
+	auto ev = gamma->add_entryvar(x);
+
+	auto twenty = create_bitconstant(gamma->subregion(1), 32, 20);
+	auto check = bitult_op::create(32, ev->argument(1), twenty);
+	auto f = create_bitconstant(gamma->subregion(0), 1, 0);
+	gamma->add_exitvar({f, check});
+
+	/* switch (x & 3) with an impossible case */
+	auto three = create_bitconstant(graph.root(), 32, 3);
+	auto mask = bitand_op::create(32, x, three);
+	auto match = jive::match(32, {{0, 0}, {1, 1}, {7, 2}}, 3, 4, mask);
+	auto ex = graph.add_export(match, {jive::ctltype(4), "m"});
+
+//	jive::view(graph.root(), stdout);
+	jlm::vra(graph);
+//	jive::view(graph.root(), stdout);
+
+	assert(is_true(gamma->subregion(1)->result(0)->origin()));
+
+	auto mop = dynamic_cast<const jive::match_op*>(&ex->origin()->node()->operation());
+	assert(mop && std::distance(mop->begin(), mop->end()) == 2);
+}
+
+static int
+verify()
+{
+	test_theta();
+	test_gamma();
+
+	return 0;
+}
+
+JLM_UNIT_TEST_REGISTER("libjlm/opt/test-vra", verify)